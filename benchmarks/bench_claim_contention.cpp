@@ -0,0 +1,160 @@
+/*
+Terrain contention benchmark, one column per lock policy.
+
+Every thread walks ALL cells of the same terrain in its own random order
+and, for each cell, does what a drone worker does on a move:
+
+    available_neighbors(cell)
+    try_claim_cell(cell)
+
+so all threads fight over the same cells. This is run on
+BasicTerrain<Lock, AtomicStorage> for
+
+    GlobalMutexLock   one mutex
+    StripedLock       one mutex per 4 rows, a claim holds 1 or 2
+    AtomicCellsLock   no lock, fetch_or claims
+
+at 1, 4, 16 and 64 threads.
+
+The number of successful claims must equal the number of cells for
+every policy (exactly one winner per cell).
+
+Usage:
+
+    bench_claim_contention [size]
+
+    size   terrain is size x size (default 512)
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "aeroswarm/terrain.hpp"
+
+namespace {
+
+struct Result {
+    double seconds{0.0};
+    std::size_t claims{0};
+    std::size_t checksum{0};
+};
+
+
+template <typename LockPolicy>
+Result run(int size, int thread_count)
+{
+    BasicTerrain<LockPolicy, AtomicStorage> terrain{size, size};
+
+    std::vector<Position> cells;
+    cells.reserve(static_cast<std::size_t>(size) * size);
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            cells.push_back({x, y});
+        }
+    }
+
+    // Each thread gets its own visiting order, prepared before timing.
+    std::vector<std::vector<Position>> orders(thread_count, cells);
+
+    for (int t = 0; t < thread_count; ++t) {
+        std::mt19937 rng(static_cast<unsigned int>(t));
+        std::shuffle(orders[t].begin(), orders[t].end(), rng);
+    }
+
+    std::atomic<std::size_t> claims{0};
+    std::atomic<std::size_t> checksum{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+
+            std::size_t local_claims = 0;
+            std::size_t local_checksum = 0;
+
+            for (const auto& pos : orders[t]) {
+                local_checksum +=
+                    terrain.available_neighbors(pos).size();
+
+                if (terrain.try_claim_cell(pos)) {
+                    ++local_claims;
+                }
+            }
+
+            claims.fetch_add(local_claims);
+            checksum.fetch_add(local_checksum);
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    return Result{
+        std::chrono::duration<double>(stop - start).count(),
+        claims.load(),
+        checksum.load()
+    };
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const int size =
+        argc > 1 ? std::atoi(argv[1]) : 512;
+
+    const std::size_t cell_count =
+        static_cast<std::size_t>(size) * static_cast<std::size_t>(size);
+
+    std::cout
+        << "Terrain " << size << "x" << size
+        << ", every thread: available_neighbors + try_claim_cell"
+        << " on every cell\n"
+        << "hardware threads: "
+        << std::thread::hardware_concurrency() << "\n\n";
+
+    std::cout
+        << "threads   mutex Mops/s   striped Mops/s   atomic Mops/s\n";
+
+    for (const int threads : {1, 4, 16, 64}) {
+        const Result locked = run<GlobalMutexLock>(size, threads);
+        const Result striped = run<StripedLock>(size, threads);
+        const Result atomic = run<AtomicCellsLock>(size, threads);
+
+        if (locked.claims != cell_count ||
+            striped.claims != cell_count ||
+            atomic.claims != cell_count) {
+            std::cerr << "claim count mismatch\n";
+            return 1;
+        }
+
+        const double operations =
+            static_cast<double>(cell_count) * threads;
+
+        std::cout
+            << threads << "\t  "
+            << operations / locked.seconds / 1.0e6 << "\t "
+            << operations / striped.seconds / 1.0e6 << "\t\t  "
+            << operations / atomic.seconds / 1.0e6 << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+/*
+Drone position storage under contention.
+
+256 threads (one per drone, like ParallelExecution::ThreadPerDrone)
+each repeat the position part of a move:
+
+    read own position, write own position
+
+while one reader thread keeps copying all positions, like snapshot().
+
+    locked   the previous ParallelSimulation layout: std::vector<Drone>
+             behind a std::shared_mutex (shared lock to read, unique
+             lock to write, shared lock for the copy)
+
+    packed   the current layout: one 64-bit atomic per drone on its own
+             cache line, seqlock-validated copy (writers pause for a
+             reader that failed 8 times in a row)
+
+Reported per mode: mean time per move per thread, and how many
+consistent copies the reader got.
+
+Usage:
+
+    bench_drone_positions [drones] [moves per drone]
+
+    defaults: 256 drones, 20000 moves
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "aeroswarm/drone.hpp"
+
+namespace {
+
+// Reference copy of the old storage, kept only for comparison.
+class LockedPositions {
+public:
+    explicit LockedPositions(std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            drones_.emplace_back(static_cast<int>(i), Position{0, 0});
+        }
+    }
+
+    Position load(std::size_t index) const {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+        return drones_[index].position();
+    }
+
+    void store(std::size_t index, const Position& pos) {
+        std::unique_lock<std::shared_mutex> lock(mtx_);
+        drones_[index].move_to(pos);
+    }
+
+    void collect(std::vector<Position>& out) const {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+
+        out.clear();
+
+        for (const auto& drone : drones_) {
+            out.push_back(drone.position());
+        }
+    }
+
+private:
+    std::vector<Drone> drones_;
+    mutable std::shared_mutex mtx_;
+};
+
+
+// Same scheme as ParallelSimulation::collect_positions().
+class PackedPositions {
+public:
+    explicit PackedPositions(std::size_t count)
+        : slots_(std::make_unique<Slot[]>(count)),
+          count_(count)
+    {
+    }
+
+    Position load(std::size_t index) const {
+        const std::uint64_t packed =
+            slots_[index].packed.load(std::memory_order_relaxed);
+
+        return Position{
+            static_cast<int>(static_cast<std::uint32_t>(packed)),
+            static_cast<int>(static_cast<std::uint32_t>(packed >> 32))
+        };
+    }
+
+    void store(std::size_t index, const Position& pos) {
+        while (pending_readers_.load(std::memory_order_relaxed) > 0) {
+            std::this_thread::yield();
+        }
+
+        begun_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slots_[index].packed.store(
+            static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.x)) |
+            (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.y))
+                << 32),
+            std::memory_order_relaxed
+        );
+
+        done_.fetch_add(1, std::memory_order_release);
+    }
+
+    void collect(std::vector<Position>& out) const {
+        bool paused = false;
+
+        for (int attempt = 0; ; ++attempt) {
+            if (attempt == 8) {
+                pending_readers_.fetch_add(1);
+                paused = true;
+            }
+
+            const std::size_t done =
+                done_.load(std::memory_order_acquire);
+
+            out.clear();
+
+            for (std::size_t i = 0; i < count_; ++i) {
+                out.push_back(load(i));
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (begun_.load(std::memory_order_relaxed) == done) {
+                break;
+            }
+        }
+
+        if (paused) {
+            pending_readers_.fetch_sub(1);
+        }
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> packed{0};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t count_;
+    std::atomic<std::size_t> begun_{0};
+    std::atomic<std::size_t> done_{0};
+    mutable std::atomic<int> pending_readers_{0};
+};
+
+
+template <typename Positions>
+void run(const char* name,
+         std::size_t drones,
+         std::size_t moves)
+{
+    Positions positions{drones};
+
+    std::atomic<bool> go{false};
+    std::atomic<bool> finished{false};
+    std::size_t copies = 0;
+
+    std::thread reader([&]() {
+        std::vector<Position> out;
+        out.reserve(drones);
+
+        while (!go.load()) {
+            std::this_thread::yield();
+        }
+
+        while (!finished.load()) {
+            positions.collect(out);
+            ++copies;
+        }
+    });
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t d = 0; d < drones; ++d) {
+        threads.emplace_back([&, d]() {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+
+            for (std::size_t i = 0; i < moves; ++i) {
+                Position pos = positions.load(d);
+                pos.x = static_cast<int>(i);
+                positions.store(d, pos);
+            }
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    finished.store(true);
+    reader.join();
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(stop - start).count();
+
+    std::cout
+        << "  " << name
+        << ": " << nanoseconds / static_cast<double>(moves)
+        << " ns/move per thread, "
+        << copies << " consistent copies\n";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const std::size_t drones =
+        argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+
+    const std::size_t moves =
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+
+    std::cout
+        << drones << " drone threads x " << moves
+        << " moves + 1 snapshot reader, hardware threads: "
+        << std::thread::hardware_concurrency() << '\n';
+
+    run<LockedPositions>("locked", drones, moves);
+    run<PackedPositions>("packed", drones, moves);
+
+    return 0;
+}
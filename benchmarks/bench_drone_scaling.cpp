@@ -0,0 +1,132 @@
+/*
+Drone count scaling: ThreadPerDrone vs ThreadPool vs Lockstep.
+
+For each drone count, a LockFree terrain with ~64 cells per drone
+(at least 64 x 64) and a walled-in target, so every run explores until
+all drones are stuck. Drones start on random cells.
+
+    thread/drone   ParallelExecution::ThreadPerDrone
+                   (skipped above max_thread_per_drone drones)
+
+    pool           ParallelExecution::ThreadPool, worker_threads threads
+
+    lockstep       ParallelExecution::Lockstep, worker_threads threads
+
+Reported: wall time and visited cells per second (tick counts rounds
+in lockstep mode, so moves are taken from the terrain instead).
+
+Usage:
+
+    bench_drone_scaling [pool threads] [max thread/drone]
+
+    defaults: hardware_concurrency threads, 4096
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "aeroswarm/parallel/simulation.hpp"
+
+namespace {
+
+struct Result {
+    double seconds{0.0};
+    std::size_t visited{0};
+};
+
+
+Result run(std::size_t drone_count,
+           ParallelExecution execution,
+           std::size_t worker_threads)
+{
+    const int size = std::max(
+        64,
+        static_cast<int>(std::sqrt(64.0 * static_cast<double>(drone_count)))
+    );
+
+    ParallelTerrain terrain{size, size, TerrainSynchronization::LockFree};
+
+    terrain.set_target({size - 1, size - 1});
+    terrain.set_obstacle({size - 2, size - 1});
+    terrain.set_obstacle({size - 1, size - 2});
+    terrain.set_obstacle({size - 2, size - 2});
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> coord(0, size - 3);
+
+    std::vector<Drone> drones;
+    drones.reserve(drone_count);
+
+    for (std::size_t id = 0; id < drone_count; ++id) {
+        drones.emplace_back(
+            static_cast<int>(id),
+            Position{coord(rng), coord(rng)}
+        );
+    }
+
+    ParallelSimulationOptions options;
+    options.execution = execution;
+    options.worker_threads = worker_threads;
+
+    ParallelSimulation simulation{terrain, std::move(drones), 42, options};
+
+    const auto start = std::chrono::steady_clock::now();
+    simulation.run();
+    const auto stop = std::chrono::steady_clock::now();
+
+    return Result{
+        std::chrono::duration<double>(stop - start).count(),
+        terrain.visited_count()
+    };
+}
+
+
+void print(const Result& result) {
+    std::cout
+        << result.seconds * 1.0e3 << " ms, "
+        << static_cast<double>(result.visited) / result.seconds / 1.0e6
+        << " M cells/s";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const std::size_t pool_threads =
+        argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+                 : std::thread::hardware_concurrency();
+
+    const std::size_t max_thread_per_drone =
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4096;
+
+    std::cout
+        << "pool threads: " << pool_threads
+        << ", hardware threads: "
+        << std::thread::hardware_concurrency() << "\n\n";
+
+    for (const std::size_t drones :
+         {4u, 16u, 64u, 256u, 1024u, 4096u, 16384u, 100000u}) {
+
+        std::cout << drones << " drones\n  thread/drone: ";
+
+        if (drones <= max_thread_per_drone) {
+            print(run(drones, ParallelExecution::ThreadPerDrone, 0));
+        } else {
+            std::cout << "skipped";
+        }
+
+        std::cout << "\n  pool:         ";
+        print(run(drones, ParallelExecution::ThreadPool, pool_threads));
+        std::cout << "\n  lockstep:     ";
+        print(run(drones, ParallelExecution::Lockstep, pool_threads));
+        std::cout << '\n';
+    }
+
+    return 0;
+}
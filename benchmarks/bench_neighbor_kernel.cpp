@@ -0,0 +1,263 @@
+/*
+Neighbor enumeration: per-direction loop vs bitboard.
+
+    queries   available_neighbors() on random cells
+        loop      the previous ParallelTerrain path: 8 bounds checks and
+                  8 acquire loads of PackedCell bytes, one branch each
+        bitboard  the current path: 3x3 window of the obstacle and
+                  visited bitplanes + precomputed lookup table
+
+    gain      information gain of every cell of the map
+        loop      per cell, per direction (the old constructor)
+        scalar    count_open_neighbors(), 64 cells per word
+        avx2      count_open_neighbors(), 256 cells per step
+                  (skipped when the CPU has no AVX2)
+
+Both maps have ~10 % obstacles and ~30 % visited cells.
+
+Usage:
+
+    bench_neighbor_kernel [size] [queries]
+
+    size     map is size x size       (default 1024)
+    queries  neighbor queries per run (default 4000000)
+*/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "aeroswarm/bitboard.hpp"
+#include "aeroswarm/packed_cell.hpp"
+#include "aeroswarm/parallel/terrain.hpp"
+
+namespace {
+
+constexpr std::array<Position, 8> directions{{
+    {0, 1}, {0, -1}, {1, 0}, {-1, 0},
+    {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+}};
+
+
+// Reference copy of the old byte-per-cell neighbor loop, kept only for
+// comparison.
+class ByteGrid {
+public:
+    ByteGrid(int w, int h)
+        : width_(w),
+          height_(h),
+          cells_(std::make_unique<std::atomic<PackedCell>[]>(
+              static_cast<std::size_t>(w) * h))
+    {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(w) * h; ++i) {
+            cells_[i].store(pack_cell(CellType::Free, false));
+        }
+    }
+
+    void set(const Position& pos, PackedCell cell) {
+        cells_[index(pos)].store(cell);
+    }
+
+    Neighbors available_neighbors(const Position& pos) const {
+        Neighbors candidates;
+
+        for (const auto& dir : directions) {
+            const Position next = pos + dir;
+
+            if (next.x < 0 || next.y < 0 ||
+                next.x >= width_ || next.y >= height_) {
+                continue;
+            }
+
+            if (cell_available(
+                    cells_[index(next)].load(std::memory_order_acquire))) {
+                candidates.positions[candidates.count++] = next;
+            }
+        }
+
+        return candidates;
+    }
+
+    int open_neighbors(const Position& pos) const {
+        return static_cast<int>(available_neighbors(pos).size());
+    }
+
+private:
+    std::size_t index(const Position& pos) const {
+        return static_cast<std::size_t>(pos.y) *
+               static_cast<std::size_t>(width_) +
+               static_cast<std::size_t>(pos.x);
+    }
+
+    int width_;
+    int height_;
+    std::unique_ptr<std::atomic<PackedCell>[]> cells_;
+};
+
+
+template <typename Function>
+double time_ms(Function&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+template <typename Grid>
+void run_queries(const char* name,
+                 const Grid& grid,
+                 const std::vector<Position>& queries)
+{
+    std::size_t total = 0;
+
+    const double ms = time_ms([&]() {
+        for (const auto& pos : queries) {
+            total += grid.available_neighbors(pos).size();
+        }
+    });
+
+    std::cout
+        << "  " << name << ": "
+        << static_cast<double>(queries.size()) / ms / 1000.0
+        << " M queries/s (checksum " << total << ")\n";
+}
+
+
+void run_gain_kernel(NeighborKernel kernel,
+                     const Bitboard& obstacles,
+                     const Bitboard& visited,
+                     int size)
+{
+    const std::size_t stride = obstacles.stride();
+
+    std::vector<std::uint64_t> rows(3 * (stride + 2), ~std::uint64_t{0});
+    std::vector<std::uint8_t> counts(stride * 64);
+    std::vector<std::uint8_t> gain(static_cast<std::size_t>(size) * size);
+
+    const double ms = time_ms([&]() {
+        for (int y = 0; y < size; ++y) {
+            for (int r = 0; r < 3; ++r) {
+                std::uint64_t* row = rows.data() + r * (stride + 2) + 1;
+
+                obstacles.copy_row(y + r, row);
+                visited.or_row(y + r, row);
+            }
+
+            count_open_neighbors(
+                kernel,
+                rows.data() + 1,
+                rows.data() + (stride + 2) + 1,
+                rows.data() + 2 * (stride + 2) + 1,
+                stride,
+                neighbor_window_mask(directions),
+                counts.data()
+            );
+
+            for (int x = 0; x < size; ++x) {
+                gain[static_cast<std::size_t>(y) * size + x] =
+                    counts[static_cast<std::size_t>(x) + 1];
+            }
+        }
+    });
+
+    std::size_t total = 0;
+
+    for (const auto value : gain) {
+        total += value;
+    }
+
+    std::cout
+        << "  " << neighbor_kernel_name(kernel) << ": " << ms
+        << " ms (checksum " << total << ")\n";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const int size =
+        argc > 1 ? std::atoi(argv[1]) : 1024;
+
+    const std::size_t query_count =
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4000000;
+
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> coordinate(0, size - 1);
+    std::uniform_int_distribution<int> roll(0, 99);
+
+    ByteGrid grid{size, size};
+    ParallelTerrain terrain{size, size, TerrainSynchronization::LockFree};
+
+    Bitboard obstacles{size, size, true};
+    Bitboard visited{size, size, false};
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            const int value = roll(rng);
+
+            if (value < 10) {
+                grid.set({x, y}, pack_cell(CellType::Obstacle, false));
+                terrain.set_obstacle({x, y});
+                obstacles.set({x, y});
+            } else if (value < 40) {
+                grid.set({x, y}, pack_cell(CellType::Free, true));
+                terrain.try_claim_cell({x, y});
+                visited.set({x, y});
+            }
+        }
+    }
+
+    std::vector<Position> queries;
+    queries.reserve(query_count);
+
+    for (std::size_t i = 0; i < query_count; ++i) {
+        queries.push_back({coordinate(rng), coordinate(rng)});
+    }
+
+    std::cout << size << " x " << size << ", " << query_count
+              << " neighbor queries\n";
+
+    std::cout << "queries\n";
+    run_queries("loop", grid, queries);
+    run_queries("bitboard", terrain, queries);
+
+    std::cout << "gain\n";
+
+    {
+        std::vector<std::uint8_t> gain(static_cast<std::size_t>(size) * size);
+
+        const double ms = time_ms([&]() {
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    gain[static_cast<std::size_t>(y) * size + x] =
+                        static_cast<std::uint8_t>(grid.open_neighbors({x, y}));
+                }
+            }
+        });
+
+        std::size_t total = 0;
+
+        for (const auto value : gain) {
+            total += value;
+        }
+
+        std::cout << "  loop: " << ms << " ms (checksum " << total << ")\n";
+    }
+
+    run_gain_kernel(NeighborKernel::Scalar, obstacles, visited, size);
+
+    if (neighbor_kernel_supported(NeighborKernel::Avx2)) {
+        run_gain_kernel(NeighborKernel::Avx2, obstacles, visited, size);
+    }
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+Snapshot consumer impact on drone workers.
+
+Runs the same ParallelSimulation (no update pacing, target unreachable so
+every drone explores until it is boxed in) three times:
+
+    none        no consumer
+    direct      a consumer thread calls snapshot() every frame
+                (drones_mutex_ shared lock + winner lock per frame)
+    published   snapshot_interval = frame time, the consumer calls
+                latest_snapshot() every frame (triple buffer)
+
+Both consumers accumulate the visited delta like the renderer does.
+
+A single run is short (drones box themselves in within a few thousand
+moves), so every mode is repeated and the totals are reported: wall
+time, moves, mean time per move per worker thread and frames taken by
+the consumer.
+
+Usage:
+
+    bench_snapshot_latency [drones] [size] [frame ms] [repeats]
+
+    defaults: 16 drones, 512 x 512 terrain, 16 ms frames, 50 repeats
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "aeroswarm/parallel/simulation.hpp"
+
+namespace {
+
+enum class Consumer {
+    None,
+    Direct,
+    Published
+};
+
+
+struct Totals {
+    double nanoseconds{0.0};
+    std::size_t moves{0};
+    std::size_t frames{0};
+    std::size_t checksum{0};
+};
+
+
+void run_once(Consumer consumer,
+              int drone_count,
+              int size,
+              std::chrono::milliseconds frame_time,
+              unsigned int seed,
+              Totals& totals)
+{
+    ParallelTerrain terrain{size, size, TerrainSynchronization::LockFree};
+
+    // Walled-in target: the run only ends when every drone is stuck.
+    terrain.set_target({size - 1, size - 1});
+    terrain.set_obstacle({size - 2, size - 1});
+    terrain.set_obstacle({size - 1, size - 2});
+    terrain.set_obstacle({size - 2, size - 2});
+
+    std::vector<Drone> drones;
+
+    for (int id = 0; id < drone_count; ++id) {
+        drones.emplace_back(id, Position{(id * 7) % size, (id * 13) % size});
+    }
+
+    ParallelSimulationOptions options;
+
+    if (consumer == Consumer::Published) {
+        options.snapshot_interval = frame_time;
+    }
+
+    ParallelSimulation simulation{terrain, drones, seed, options};
+
+    std::atomic<bool> finished{false};
+    std::size_t frames = 0;
+    std::size_t checksum = 0;
+
+    std::thread consumer_thread;
+
+    if (consumer != Consumer::None) {
+        consumer_thread = std::thread([&]() {
+            std::size_t epoch = 0;
+
+            while (!finished.load()) {
+                const auto snapshot = consumer == Consumer::Direct
+                    ? simulation.snapshot(epoch)
+                    : simulation.latest_snapshot(epoch);
+
+                epoch = snapshot.visited_epoch;
+                checksum += snapshot.drone_positions.size();
+                ++frames;
+
+                std::this_thread::sleep_for(frame_time);
+            }
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    simulation.run();
+    const auto stop = std::chrono::steady_clock::now();
+
+    finished.store(true);
+
+    if (consumer_thread.joinable()) {
+        consumer_thread.join();
+    }
+
+    totals.nanoseconds +=
+        std::chrono::duration<double, std::nano>(stop - start).count();
+    totals.moves += simulation.snapshot().tick;
+    totals.frames += frames;
+    totals.checksum += checksum;
+}
+
+
+void run(const char* name,
+         Consumer consumer,
+         int drone_count,
+         int size,
+         std::chrono::milliseconds frame_time,
+         int repeats)
+{
+    Totals totals;
+
+    for (int r = 0; r < repeats; ++r) {
+        run_once(consumer, drone_count, size, frame_time,
+                 static_cast<unsigned int>(r), totals);
+    }
+
+    std::cout
+        << "  " << name
+        << ": " << totals.nanoseconds / 1.0e6 << " ms, "
+        << totals.moves << " moves, "
+        << totals.nanoseconds * drone_count /
+           static_cast<double>(totals.moves)
+        << " ns/move per thread, "
+        << totals.frames << " frames"
+        << "  (checksum " << totals.checksum << ")\n";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const int drones =
+        argc > 1 ? std::atoi(argv[1]) : 16;
+
+    const int size =
+        argc > 2 ? std::atoi(argv[2]) : 512;
+
+    const std::chrono::milliseconds frame_time{
+        argc > 3 ? std::atoi(argv[3]) : 16
+    };
+
+    const int repeats =
+        argc > 4 ? std::atoi(argv[4]) : 50;
+
+    std::cout
+        << drones << " drones, " << size << "x" << size
+        << " terrain (LockFree), " << frame_time.count()
+        << " ms frames, " << repeats << " repeats\n";
+
+    run("none     ", Consumer::None, drones, size, frame_time, repeats);
+    run("direct   ", Consumer::Direct, drones, size, frame_time, repeats);
+    run("published", Consumer::Published, drones, size, frame_time, repeats);
+
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+Terrain storage layout benchmark.
+
+Compares the previous nested layout
+
+    std::vector<std::vector<Cell>>     (one heap block per column,
+                                        8-byte Cell)
+
+with the current flat row-major PackedCell buffer used by Terrain and
+ParallelTerrain.
+
+Reported:
+    - bytes per cell
+    - available_neighbors() queries per second on random cells
+
+Usage:
+
+    bench_terrain_layout [size] [queries]
+
+    size     map is size x size       (default 4096)
+    queries  neighbor queries per run (default 4000000)
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "aeroswarm/parallel/terrain.hpp"
+#include "aeroswarm/sequential/terrain.hpp"
+
+namespace {
+
+// The Cell layout before the packed encoding: int-sized enum + bool.
+enum class LegacyCellType {
+    Free,
+    Obstacle,
+    Target
+};
+
+struct LegacyCell {
+    LegacyCellType type{LegacyCellType::Free};
+    bool visited{false};
+};
+
+
+/*
+Reference copy of the old storage, kept only for comparison.
+Mirrors the old ParallelTerrain::available_neighbors (8 directions,
+global mutex) and the old Terrain::available_neighbors (4 directions).
+*/
+class NestedGrid {
+public:
+    NestedGrid(int w, int h)
+        : width_(w),
+          height_(h),
+          grid_(w, std::vector<LegacyCell>(h))
+    {
+    }
+
+    void set_obstacle(const Position& pos) {
+        grid_[pos.x][pos.y].type = LegacyCellType::Obstacle;
+    }
+
+    void mark_visited(const Position& pos) {
+        grid_[pos.x][pos.y].visited = true;
+    }
+
+    // Old Terrain::available_neighbors: 4 directions, std::vector.
+    std::vector<Position> available_neighbors_vector(
+        const Position& pos) const
+    {
+        std::vector<Position> candidates;
+
+        for (const auto& dir : four_directions_) {
+            const Position next = pos + dir;
+
+            if (free_and_unvisited(next)) {
+                candidates.push_back(next);
+            }
+        }
+
+        return candidates;
+    }
+
+    // Old ParallelTerrain::available_neighbors: 8 directions, mutex.
+    Neighbors available_neighbors(const Position& pos) const {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        Neighbors candidates;
+
+        for (const auto& dir : eight_directions_) {
+            const Position next = pos + dir;
+
+            if (free_and_unvisited(next)) {
+                candidates.positions[candidates.count] = next;
+                ++candidates.count;
+            }
+        }
+
+        return candidates;
+    }
+
+    std::size_t storage_bytes() const {
+        return grid_.capacity() * sizeof(std::vector<LegacyCell>) +
+               grid_.size() * grid_.front().capacity() * sizeof(LegacyCell);
+    }
+
+private:
+    int width_;
+    int height_;
+    std::vector<std::vector<LegacyCell>> grid_;
+    mutable std::mutex mtx_;
+
+    const std::vector<Position> four_directions_{
+        {1, 0}, {-1, 0}, {0, 1}, {0, -1}
+    };
+
+    const std::vector<Position> eight_directions_{
+        {0, 1}, {0, -1}, {1, 0}, {-1, 0},
+        {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+    };
+
+    bool free_and_unvisited(const Position& next) const {
+        if (next.x < 0 || next.x >= width_ ||
+            next.y < 0 || next.y >= height_) {
+            return false;
+        }
+
+        if (grid_[next.x][next.y].type == LegacyCellType::Obstacle) {
+            return false;
+        }
+
+        return !grid_[next.x][next.y].visited;
+    }
+};
+
+
+template <typename Query>
+void report(const char* name,
+            const std::vector<Position>& queries,
+            Query&& query)
+{
+    std::size_t checksum = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto& pos : queries) {
+        checksum += query(pos);
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds =
+        std::chrono::duration<double>(stop - start).count();
+
+    std::cout
+        << "  " << name << ": "
+        << static_cast<double>(queries.size()) / seconds / 1.0e6
+        << " M queries/s"
+        << "  (checksum " << checksum << ")\n";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const int size =
+        argc > 1 ? std::atoi(argv[1]) : 4096;
+
+    const std::size_t query_count =
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4000000;
+
+    const double cells =
+        static_cast<double>(size) * static_cast<double>(size);
+
+    NestedGrid nested{size, size};
+    Terrain terrain{size, size};
+    ParallelTerrain parallel_terrain{size, size};
+
+    // Same layout on all three: ~10% obstacles, ~30% visited.
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> coord(0, size - 1);
+    std::uniform_real_distribution<double> roll(0.0, 1.0);
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            const double r = roll(rng);
+
+            if (r < 0.10) {
+                nested.set_obstacle({x, y});
+                terrain.set_obstacle({x, y});
+                parallel_terrain.set_obstacle({x, y});
+            } else if (r < 0.40) {
+                nested.mark_visited({x, y});
+                terrain.mark_visited({x, y});
+                parallel_terrain.try_claim_cell({x, y});
+            }
+        }
+    }
+
+    std::vector<Position> queries;
+    queries.reserve(query_count);
+
+    for (std::size_t i = 0; i < query_count; ++i) {
+        queries.push_back({coord(rng), coord(rng)});
+    }
+
+    std::cout
+        << "Terrain " << size << "x" << size
+        << ", " << query_count << " random neighbor queries\n\n";
+
+    std::cout
+        << "Bytes per cell\n"
+        << "  nested vector<vector<Cell>>: "
+        << static_cast<double>(nested.storage_bytes()) / cells << '\n'
+        << "  flat PackedCell:             "
+        << static_cast<double>(terrain.storage_bytes()) / cells << "\n\n";
+
+    std::cout << "4-connected, no lock (Terrain)\n";
+
+    report("nested", queries, [&](const Position& pos) {
+        return nested.available_neighbors_vector(pos).size();
+    });
+
+    report("flat  ", queries, [&](const Position& pos) {
+        return terrain.available_neighbors(pos).size();
+    });
+
+    std::cout << "\n8-connected, global mutex (ParallelTerrain)\n";
+
+    report("nested", queries, [&](const Position& pos) {
+        return nested.available_neighbors(pos).size();
+    });
+
+    report("flat  ", queries, [&](const Position& pos) {
+        return parallel_terrain.available_neighbors(pos).size();
+    });
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+Tiled locking vs the global mutex, for spread-out and clustered drones.
+
+A size x size terrain with a walled-in target, so every run explores
+until all drones are stuck, run by ParallelSimulation (ThreadPool) on
+
+    mutex     TerrainSynchronization::GlobalMutex
+    tiled     TerrainSynchronization::Tiled (32 x 32 tiles)
+    atomic    TerrainSynchronization::LockFree, for reference
+
+with two kinds of drone starts:
+
+    spread     one drone per cell of an even grid over the whole map,
+               so drones mostly stay in different tiles
+    clustered  every drone starts in the 16 x 16 block at the center,
+               so they share one to four tiles until they spread out
+
+Reported: wall time and visited cells per second, best of 3 runs.
+
+Usage:
+
+    bench_tiled_locking [size] [drones] [pool threads]
+
+    defaults: 512, 64, hardware_concurrency
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "aeroswarm/parallel/simulation.hpp"
+
+namespace {
+
+struct Result {
+    double seconds{0.0};
+    std::size_t visited{0};
+};
+
+
+std::vector<Position> spread_starts(int size, std::size_t drone_count) {
+    const int per_row = std::max(
+        1,
+        static_cast<int>(std::ceil(std::sqrt(static_cast<double>(drone_count))))
+    );
+
+    const int spacing = std::max(1, (size - 2) / per_row);
+
+    std::vector<Position> starts;
+
+    for (std::size_t id = 0; id < drone_count; ++id) {
+        const int column = static_cast<int>(id) % per_row;
+        const int row = static_cast<int>(id) / per_row;
+
+        starts.push_back({
+            std::min(size - 3, column * spacing + spacing / 2),
+            std::min(size - 3, row * spacing + spacing / 2)
+        });
+    }
+
+    return starts;
+}
+
+
+std::vector<Position> clustered_starts(int size, std::size_t drone_count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> offset(0, 15);
+
+    const int corner = std::max(0, size / 2 - 8);
+
+    std::vector<Position> starts;
+
+    for (std::size_t id = 0; id < drone_count; ++id) {
+        starts.push_back({
+            std::min(size - 3, corner + offset(rng)),
+            std::min(size - 3, corner + offset(rng))
+        });
+    }
+
+    return starts;
+}
+
+
+Result run(int size,
+           const std::vector<Position>& starts,
+           TerrainSynchronization synchronization,
+           std::size_t worker_threads)
+{
+    ParallelTerrain terrain{size, size, synchronization};
+
+    terrain.set_target({size - 1, size - 1});
+    terrain.set_obstacle({size - 2, size - 1});
+    terrain.set_obstacle({size - 1, size - 2});
+    terrain.set_obstacle({size - 2, size - 2});
+
+    std::vector<Drone> drones;
+    drones.reserve(starts.size());
+
+    for (std::size_t id = 0; id < starts.size(); ++id) {
+        drones.emplace_back(static_cast<int>(id), starts[id]);
+    }
+
+    ParallelSimulationOptions options;
+    options.execution = ParallelExecution::ThreadPool;
+    options.worker_threads = worker_threads;
+
+    ParallelSimulation simulation{terrain, std::move(drones), 42, options};
+
+    const auto start = std::chrono::steady_clock::now();
+    simulation.run();
+    const auto stop = std::chrono::steady_clock::now();
+
+    return Result{
+        std::chrono::duration<double>(stop - start).count(),
+        terrain.visited_count()
+    };
+}
+
+
+Result best_of(int size,
+               const std::vector<Position>& starts,
+               TerrainSynchronization synchronization,
+               std::size_t worker_threads)
+{
+    Result best = run(size, starts, synchronization, worker_threads);
+
+    for (int i = 1; i < 3; ++i) {
+        const Result next = run(size, starts, synchronization, worker_threads);
+
+        if (next.seconds < best.seconds) {
+            best = next;
+        }
+    }
+
+    return best;
+}
+
+
+void print(const char* name, const Result& result) {
+    std::cout
+        << "  " << name << ": "
+        << result.seconds * 1.0e3 << " ms, "
+        << static_cast<double>(result.visited) / result.seconds / 1.0e6
+        << " M cells/s\n";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const int size =
+        argc > 1 ? std::atoi(argv[1]) : 512;
+
+    const std::size_t drone_count =
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    const std::size_t pool_threads =
+        argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                 : std::thread::hardware_concurrency();
+
+    std::cout
+        << size << " x " << size << ", " << drone_count << " drones, "
+        << pool_threads << " pool threads, hardware threads: "
+        << std::thread::hardware_concurrency() << "\n";
+
+    const std::vector<Position> spread = spread_starts(size, drone_count);
+    const std::vector<Position> clustered = clustered_starts(size, drone_count);
+
+    for (const auto* starts : {&spread, &clustered}) {
+        std::cout << (starts == &spread ? "spread\n" : "clustered\n");
+
+        print("mutex ", best_of(size, *starts,
+                                TerrainSynchronization::GlobalMutex,
+                                pool_threads));
+        print("tiled ", best_of(size, *starts,
+                                TerrainSynchronization::Tiled,
+                                pool_threads));
+        print("atomic", best_of(size, *starts,
+                                TerrainSynchronization::LockFree,
+                                pool_threads));
+    }
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+/*
+Worker step benchmark: per-candidate queries vs scored_neighbors().
+
+Each thread drives one drone over a shared GlobalMutex ParallelTerrain
+and repeats the decision part of ParallelSimulation::worker:
+
+    separate    available_neighbors + is_target(c) + information_gain(c)
+                for every candidate c, then try_claim_cell + is_target
+                (the previous worker)
+
+    fused       scored_neighbors, then try_claim_cell
+                (the current worker)
+
+A drone that gets boxed in jumps to a random cell and keeps going, so
+every thread performs the same number of steps.
+
+Reported per mode: terrain lock acquisitions per step and mean step
+latency.
+
+Usage:
+
+    bench_worker_step [threads] [steps per thread] [size]
+
+    defaults: 4 threads, 200000 steps, 1024 x 1024 terrain
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "aeroswarm/parallel/terrain.hpp"
+
+namespace {
+
+struct StepCost {
+    std::size_t lock_acquisitions{0};
+};
+
+
+Position choose(const Neighbors& best, std::mt19937& rng) {
+    std::uniform_int_distribution<std::size_t> dist(0, best.size() - 1);
+    return best[dist(rng)];
+}
+
+
+// The previous worker: one terrain call (= one lock) per question.
+std::optional<Position> separate_step(ParallelTerrain& terrain,
+                                      const Position& current,
+                                      std::mt19937& rng,
+                                      StepCost& cost)
+{
+    const auto neighbors = terrain.available_neighbors(current);
+    ++cost.lock_acquisitions;
+
+    if (neighbors.empty()) {
+        return std::nullopt;
+    }
+
+    std::optional<Position> next;
+
+    for (const auto& candidate : neighbors) {
+        ++cost.lock_acquisitions;
+
+        if (terrain.is_target(candidate)) {
+            next = candidate;
+            break;
+        }
+    }
+
+    if (!next.has_value()) {
+        int best_gain = -1;
+        Neighbors best;
+
+        for (const auto& candidate : neighbors) {
+            const int gain = terrain.information_gain(candidate);
+            ++cost.lock_acquisitions;
+
+            if (gain > best_gain) {
+                best_gain = gain;
+                best.count = 0;
+            }
+
+            if (gain == best_gain) {
+                best[best.count] = candidate;
+                ++best.count;
+            }
+        }
+
+        next = choose(best, rng);
+    }
+
+    ++cost.lock_acquisitions;
+
+    if (!terrain.try_claim_cell(next.value())) {
+        return current;
+    }
+
+    ++cost.lock_acquisitions;
+    terrain.is_target(next.value());
+
+    return next;
+}
+
+
+// The current worker: scored_neighbors() + claim.
+std::optional<Position> fused_step(ParallelTerrain& terrain,
+                                   const Position& current,
+                                   std::mt19937& rng,
+                                   StepCost& cost)
+{
+    const auto neighbors = terrain.scored_neighbors(current);
+    ++cost.lock_acquisitions;
+
+    if (neighbors.empty()) {
+        return std::nullopt;
+    }
+
+    std::optional<Position> next;
+
+    for (const auto& candidate : neighbors) {
+        if (candidate.is_target) {
+            next = candidate.position;
+            break;
+        }
+    }
+
+    if (!next.has_value()) {
+        int best_gain = -1;
+        Neighbors best;
+
+        for (const auto& candidate : neighbors) {
+            if (candidate.information_gain > best_gain) {
+                best_gain = candidate.information_gain;
+                best.count = 0;
+            }
+
+            if (candidate.information_gain == best_gain) {
+                best[best.count] = candidate.position;
+                ++best.count;
+            }
+        }
+
+        next = choose(best, rng);
+    }
+
+    ++cost.lock_acquisitions;
+
+    if (!terrain.try_claim_cell(next.value())) {
+        return current;
+    }
+
+    return next;
+}
+
+
+template <typename Step>
+void run(const char* name,
+         int thread_count,
+         std::size_t steps,
+         int size,
+         Step step)
+{
+    ParallelTerrain terrain{size, size};
+
+    std::atomic<std::size_t> locks{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(static_cast<unsigned int>(t));
+            std::uniform_int_distribution<int> coord(0, size - 1);
+
+            Position current{coord(rng), coord(rng)};
+            StepCost cost;
+
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+
+            for (std::size_t i = 0; i < steps; ++i) {
+                const auto next = step(terrain, current, rng, cost);
+
+                current = next.has_value()
+                    ? next.value()
+                    : Position{coord(rng), coord(rng)};
+            }
+
+            locks.fetch_add(cost.lock_acquisitions);
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double total_steps =
+        static_cast<double>(steps) * thread_count;
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(stop - start).count();
+
+    std::cout
+        << "  " << name
+        << ": " << static_cast<double>(locks.load()) / total_steps
+        << " locks/step, "
+        << nanoseconds * thread_count / total_steps
+        << " ns/step per thread\n";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const int threads =
+        argc > 1 ? std::atoi(argv[1]) : 4;
+
+    const std::size_t steps =
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+
+    const int size =
+        argc > 3 ? std::atoi(argv[3]) : 1024;
+
+    std::cout
+        << threads << " threads x " << steps << " steps, "
+        << size << "x" << size << " terrain (GlobalMutex)\n";
+
+    run("separate", threads, steps, size, separate_step);
+    run("fused   ", threads, steps, size, fused_step);
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "aeroswarm/app/online_statistics.hpp"
+#include "aeroswarm/frontier.hpp"
+
+/*
+Monte Carlo batch runs.
+
+Every combination of map size x drone count is run for
+seeds_per_config seeds (random scenarios, see make_random_scenario).
+Runs are independent and spread over a pool of worker_threads threads;
+each pool thread pulls the next run index until the batch is done.
+
+    run index ──► (map size, drone count, seed) ──► one simulation
+
+Per-run results are streamed as CSV rows while the batch runs, and
+folded into per-configuration summaries in constant memory: nothing
+proportional to the number of runs is kept.
+*/
+
+enum class BatchEngine {
+    // Sequential Simulation (one step moves every drone once).
+    Sequential,
+
+    // ParallelSimulation in Lockstep mode on one thread per run: the
+    // batch pool already uses every core, and lockstep keeps each run
+    // reproducible from its seed.
+    Parallel
+};
+
+
+struct BatchConfig {
+    // Square maps, size x size.
+    std::vector<int> map_sizes{30};
+    std::vector<int> drone_counts{4};
+
+    // Fraction of cells turned into obstacles (80 / 900 in main).
+    double obstacle_density{0.09};
+
+    unsigned int first_seed{1};
+    std::size_t seeds_per_config{1000};
+
+    BatchEngine engine{BatchEngine::Sequential};
+
+    // What boxed-in drones do, for both engines.
+    StuckRecovery recovery{StuckRecovery::Stop};
+
+    // 0 = std::thread::hardware_concurrency().
+    std::size_t worker_threads{0};
+
+    // Wall-clock limit per run (0 = none).
+    std::chrono::milliseconds run_time_limit{0};
+};
+
+
+enum class BatchRunStatus {
+    TargetFound,
+    Stuck,
+    DeadlineExceeded
+};
+
+
+struct BatchRunResult {
+    std::size_t run_index{0};
+    int map_size{0};
+    int drone_count{0};
+    unsigned int seed{0};
+
+    BatchRunStatus status{BatchRunStatus::Stuck};
+
+    // Rounds: sequential steps / lockstep ticks.
+    std::size_t ticks{0};
+    std::optional<std::size_t> winning_tick;
+    std::optional<int> winning_drone_id;
+
+    std::size_t visited_cells{0};
+    double wall_ms{0.0};
+};
+
+
+// One map size x drone count combination.
+struct BatchConfigSummary {
+    int map_size{0};
+    int drone_count{0};
+
+    std::size_t runs{0};
+    std::size_t target_found{0};
+
+    // Over runs that found the target.
+    RunningStatistics ticks_to_target;
+    P2Quantile ticks_to_target_p50{0.50};
+    P2Quantile ticks_to_target_p90{0.90};
+    P2Quantile ticks_to_target_p99{0.99};
+
+    // Over all runs.
+    RunningStatistics visited_cells;
+    RunningStatistics wall_ms;
+};
+
+
+struct BatchSummary {
+    std::vector<BatchConfigSummary> configs;
+    double wall_seconds{0.0};
+};
+
+
+// Column names of the rows written by run_batch().
+const char* batch_csv_header();
+
+/*
+Runs the whole batch. When `csv` is not null, the header and then one
+row per run are written to it as runs complete (rows arrive in
+completion order; run_index gives the logical order).
+*/
+BatchSummary run_batch(const BatchConfig& config, std::ostream* csv);
+
+// `batch` mode of the executable: runs `config`, streams rows to
+// `csv_path` (none when empty) and prints the summary table.
+int run_batch_mode(const BatchConfig& config, const std::string& csv_path);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/*
+Constant-memory statistics for streams of run results.
+
+A batch of tens of thousands of runs never stores the individual
+values: each accumulator keeps a fixed handful of numbers and is
+updated once per run.
+*/
+
+
+/*
+Count, mean, standard deviation, min and max (Welford's update, stable
+for long streams).
+*/
+class RunningStatistics {
+public:
+    void add(double value);
+
+    std::size_t count() const;
+    double mean() const;
+    // Sample standard deviation (0 with fewer than two values).
+    double stddev() const;
+    double min() const;
+    double max() const;
+
+private:
+    std::size_t count_{0};
+    double mean_{0.0};
+    double m2_{0.0};
+    double min_{0.0};
+    double max_{0.0};
+};
+
+
+/*
+One quantile estimated with the P² algorithm (Jain & Chlamtac, 1985).
+
+Five markers track the minimum, p/2, p, (1+p)/2 and the maximum; each
+new value shifts marker positions and adjusts their heights with a
+piecewise-parabolic fit. value() is the middle marker.
+
+Up to five values the exact quantile of the stored values is returned.
+*/
+class P2Quantile {
+public:
+    // 0 < p < 1, e.g. 0.5 for the median.
+    explicit P2Quantile(double p);
+
+    void add(double value);
+
+    std::size_t count() const;
+    double value() const;
+
+private:
+    double p_;
+    std::size_t count_{0};
+
+    std::array<double, 5> heights_{};
+    std::array<double, 5> positions_{};
+    std::array<double, 5> desired_{};
+    std::array<double, 5> increments_{};
+
+    double parabolic(std::size_t i, double d) const;
+    double linear(std::size_t i, int d) const;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include "aeroswarm/app/scenario.hpp"
+
+/*
+Output of the headless `record` mode (see frame_recorder.hpp).
+
+    Stream   `output` is a file: compact binary frame stream
+    Ppm      `output` is a directory: frame_000000.ppm, ...
+    Pipe     `output` is a shell command reading raw RGB24 frames
+             on stdin; {width} and {height} in it are replaced by the
+             frame size, e.g.
+
+                 ffmpeg -y -f rawvideo -pix_fmt rgb24
+                        -s {width}x{height} -r 60 -i - run.mp4
+*/
+enum class RecordFormat {
+    Stream,
+    Ppm,
+    Pipe
+};
+
+
+struct RecordConfig {
+    RecordFormat format{RecordFormat::Stream};
+    std::string output;
+
+    // Pixels per cell for Ppm / Pipe (0 = about 1024 px on the longer
+    // side, at most 20 px per cell, as in parallel-sdl).
+    int cell_size{0};
+
+    // Frames waiting for the writer thread before the record loop waits.
+    std::size_t queue_capacity{8};
+
+    // Simulation pacing and sampling, as in the live modes.
+    std::chrono::milliseconds update_interval{10};
+    std::chrono::milliseconds frame_interval{16};
+};
+
+
+// `record` mode of the executable: runs the parallel simulation and
+// records it to config.output.
+int run_record(const Scenario& scenario, const RecordConfig& config);
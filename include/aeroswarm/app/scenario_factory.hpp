@@ -7,4 +7,18 @@ Scenario make_random_scenario(
     int height,
     int obstacle_count,
     unsigned int seed
-);
\ No newline at end of file
+);
+
+
+/*
+Same, with `drone_count` drones: the first four take the corners as
+above, any further drones start on random free cells (never the
+target; several drones may share a cell).
+*/
+Scenario make_random_scenario(
+    int width,
+    int height,
+    int obstacle_count,
+    unsigned int seed,
+    int drone_count
+);
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "aeroswarm/types.hpp"
+
+/*
+One bit per terrain cell, with a one-cell sentinel border.
+
+    padded column:  0   1   2  ...  width  width+1
+                  ┌───┬───┬───┬───┬───┬───┐
+    padded row 0  │ S │ S │ S │...│ S │ S │   S: border, fixed value
+                  ├───┼───┼───┼───┼───┼───┤
+    row y         │ S │x=0│x=1│...│ . │ S │   cell (x, y) is bit x + 1
+                  ├───┼───┼───┼───┼───┼───┤   of padded row y + 1
+    ...           │   │   │   │   │   │   │
+                  ├───┼───┼───┼───┼───┼───┤
+    padded row    │ S │ S │ S │...│ S │ S │
+    height + 1    └───┴───┴───┴───┴───┴───┘
+
+Every padded row is stride() 64-bit words. Because of the border, the
+3x3 block around ANY cell is inside the board: neighbor lookups need no
+bounds checks, the border bits simply read as "blocked" (obstacle plane)
+or "not visited" (visited plane).
+
+Words are std::atomic<std::uint64_t>, so one bit can be claimed from
+many threads with a single fetch_or:
+
+    Thread A: fetch_or(bit) ── returns bit clear ── A set it
+    Thread B: fetch_or(bit) ── returns bit set   ── someone else did
+*/
+class Bitboard {
+public:
+    Bitboard(int width, int height, bool border);
+
+    // Copies are word-by-word snapshots (relaxed loads): only copy a
+    // board no other thread is writing.
+    Bitboard(const Bitboard& other);
+    Bitboard& operator=(const Bitboard& other);
+
+    Bitboard(Bitboard&&) noexcept = default;
+    Bitboard& operator=(Bitboard&&) noexcept = default;
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    // 64-bit words per padded row.
+    std::size_t stride() const {
+        return stride_;
+    }
+
+    // Single-threaded users pass std::memory_order_relaxed (a plain load).
+    bool test(const Position& pos,
+              std::memory_order order = std::memory_order_acquire) const
+    {
+        const std::size_t bit = padded_bit(pos);
+
+        return (words_[bit / 64].load(order) >> (bit % 64)) & 1u;
+    }
+
+    // True when this call changed the bit from 0 to 1.
+    bool set(const Position& pos) {
+        const std::size_t bit = padded_bit(pos);
+        const std::uint64_t mask = std::uint64_t{1} << (bit % 64);
+
+        return (words_[bit / 64].fetch_or(mask, std::memory_order_acq_rel) &
+                mask) == 0;
+    }
+
+    void clear(const Position& pos) {
+        const std::size_t bit = padded_bit(pos);
+
+        words_[bit / 64].fetch_and(
+            ~(std::uint64_t{1} << (bit % 64)),
+            std::memory_order_acq_rel
+        );
+    }
+
+    // Setup only (no concurrent writer): a plain load and store instead
+    // of an atomic read-modify-write.
+    void store_exclusive(const Position& pos, bool value) {
+        const std::size_t bit = padded_bit(pos);
+        const std::uint64_t mask = std::uint64_t{1} << (bit % 64);
+
+        std::atomic<std::uint64_t>& word = words_[bit / 64];
+        const std::uint64_t current = word.load(std::memory_order_relaxed);
+
+        word.store(
+            value ? (current | mask) : (current & ~mask),
+            std::memory_order_relaxed
+        );
+    }
+
+    /*
+    The 3x3 block centred on pos as 9 bits:
+
+        bit = (dy + 1) * 3 + (dx + 1)
+
+            dx: -1  0  1
+        dy -1:   0  1  2
+        dy  0:   3  4  5        4 is pos itself
+        dy  1:   6  7  8
+
+    Three rows, one or two word loads each, no bounds checks.
+    */
+    std::uint32_t window(const Position& pos,
+                         std::memory_order order =
+                             std::memory_order_acquire) const
+    {
+        // Padded column of x - 1 is x, padded row of y - 1 is y.
+        const std::size_t column = static_cast<std::size_t>(pos.x);
+        const std::size_t word = column / 64;
+        const unsigned shift = static_cast<unsigned>(column % 64);
+
+        std::uint32_t result = 0;
+
+        for (std::size_t dy = 0; dy < 3; ++dy) {
+            const std::size_t base =
+                (static_cast<std::size_t>(pos.y) + dy) * stride_ + word;
+
+            std::uint64_t bits = words_[base].load(order) >> shift;
+
+            // The three bits straddle two words.
+            if (shift > 61) {
+                bits |= words_[base + 1].load(order) << (64 - shift);
+            }
+
+            result |= static_cast<std::uint32_t>(bits & 7u) << (3 * dy);
+        }
+
+        return result;
+    }
+
+    // Copies padded row `padded_y` (0 .. height + 1) into out[0, stride).
+    void copy_row(int padded_y, std::uint64_t* out) const {
+        const std::size_t base =
+            static_cast<std::size_t>(padded_y) * stride_;
+
+        for (std::size_t i = 0; i < stride_; ++i) {
+            out[i] = words_[base + i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // out[i] |= padded row `padded_y`, word i.
+    void or_row(int padded_y, std::uint64_t* out) const {
+        const std::size_t base =
+            static_cast<std::size_t>(padded_y) * stride_;
+
+        for (std::size_t i = 0; i < stride_; ++i) {
+            out[i] |= words_[base + i].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t storage_bytes() const {
+        return word_count_ * sizeof(std::uint64_t);
+    }
+
+private:
+    std::size_t padded_bit(const Position& pos) const {
+        return (static_cast<std::size_t>(pos.y) + 1) * stride_ * 64 +
+               static_cast<std::size_t>(pos.x) + 1;
+    }
+
+    int width_;
+    int height_;
+    std::size_t stride_;
+    std::size_t word_count_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words_;
+};
+
+
+/*
+Window -> neighbor list, precomputed.
+
+For each of the 512 possible 3x3 windows of AVAILABLE bits, the entry
+lists which directions are available, in the order of the direction
+table it was built from:
+
+    window 0b010'000'001        directions {0,1} {0,-1} {1,0} {-1,0} ...
+              │        └─ bit 0: (-1,-1)
+              └────────── bit 7: ( 0, 1)
+    entry: count 2, directions {0 (= {0,1}), 7 (= {-1,-1})}
+
+Expanding a window into Neighbors is then one table load and <= 8
+additions, with no branch per direction, and the result is in exactly
+the order the old per-direction loop produced.
+*/
+struct NeighborLookupEntry {
+    std::uint8_t count{0};
+    std::array<std::uint8_t, 8> directions{};
+};
+
+using NeighborLookup = std::array<NeighborLookupEntry, 512>;
+
+
+template <std::size_t N>
+constexpr NeighborLookup make_neighbor_lookup(
+    const std::array<Position, N>& directions)
+{
+    static_assert(N <= 8, "a 3x3 window has at most 8 neighbors");
+
+    NeighborLookup lookup{};
+
+    for (std::size_t window = 0; window < lookup.size(); ++window) {
+        NeighborLookupEntry entry{};
+
+        for (std::size_t d = 0; d < N; ++d) {
+            const int bit =
+                (directions[d].y + 1) * 3 + (directions[d].x + 1);
+
+            if ((window >> bit) & 1u) {
+                entry.directions[entry.count] = static_cast<std::uint8_t>(d);
+                ++entry.count;
+            }
+        }
+
+        lookup[window] = entry;
+    }
+
+    return lookup;
+}
+
+
+// The window bits (see Bitboard::window) of a direction table.
+template <std::size_t N>
+constexpr std::uint32_t neighbor_window_mask(
+    const std::array<Position, N>& directions)
+{
+    std::uint32_t mask = 0;
+
+    for (const auto& dir : directions) {
+        mask |= 1u << ((dir.y + 1) * 3 + (dir.x + 1));
+    }
+
+    return mask;
+}
+
+
+/*
+Whole-row kernel: for every cell of a row, how many of its neighbors
+are NOT blocked. With blocked = obstacle | visited | border this is the
+information gain of the whole row at once.
+
+`neighbors` selects which of the 8 surrounding cells count, as window
+bits (see neighbor_window_mask()): 0x1EF for all 8, fewer for 4- and
+hex-connected grids.
+
+The neighbor bits of 64 cells are summed bit-sliced: up to eight
+shifted copies of the rows above, at and below, added with and/xor into
+four count planes (0..8 needs 4 bits). The AVX2 kernel does the same on 256
+cells per step and expands the count planes to bytes with a shuffle;
+the scalar kernel expands them through a 256-entry table.
+
+Inputs are padded rows of `words` words (see Bitboard) with ONE extra
+word on each side, i.e. row[-1] and row[words] must be readable. Their
+values only affect padded columns 0 and words * 64 - 1, which are never
+cells.
+
+Output: out[c] for every padded column c in [0, words * 64), so cell x
+of the row is out[x + 1].
+*/
+enum class NeighborKernel {
+    Scalar,
+    Avx2
+};
+
+bool neighbor_kernel_supported(NeighborKernel kernel);
+
+// Avx2 when the CPU supports it (checked once at run time), else Scalar.
+NeighborKernel default_neighbor_kernel();
+
+const char* neighbor_kernel_name(NeighborKernel kernel);
+
+void count_open_neighbors(NeighborKernel kernel,
+                          const std::uint64_t* above,
+                          const std::uint64_t* row,
+                          const std::uint64_t* below,
+                          std::size_t words,
+                          std::uint32_t neighbors,
+                          std::uint8_t* out);
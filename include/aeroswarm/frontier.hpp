@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "aeroswarm/types.hpp"
+
+/*
+What a drone does once every neighbor is visited or an obstacle.
+
+    Stop           it stays where it is for the rest of the run (the
+                   original behaviour: the worker returns, the
+                   sequential step skips it)
+
+    SeekFrontier   it flies back through visited cells to the nearest
+                   unvisited cell (the "frontier", see FrontierSearch)
+                   and explores again from there. It only stops when no
+                   unvisited cell is reachable any more.
+*/
+enum class StuckRecovery {
+    Stop,
+    SeekFrontier
+};
+
+
+/*
+Cells a boxed-in drone still has to fly through, see FrontierSearch.
+
+    cells   [ visited | visited | ... | frontier ]
+                ^
+                next
+
+Every cell but the last is already visited and is only flown over.
+The last one is the frontier cell, which the drone visits (claims) on
+arrival. A route whose frontier cell has been taken by another drone
+in the meantime is dropped and planned again.
+*/
+struct FrontierRoute {
+    std::vector<Position> cells;
+    std::size_t next{0};
+
+    bool active() const {
+        return next < cells.size();
+    }
+
+    bool at_frontier() const {
+        return next + 1 == cells.size();
+    }
+
+    const Position& frontier() const {
+        return cells.back();
+    }
+
+    void clear() {
+        cells.clear();
+        next = 0;
+    }
+};
+
+
+/*
+Breadth-first search from a boxed-in drone to the nearest unvisited,
+non-obstacle cell, moving through any non-obstacle cell:
+
+    # # # # # #          D  drone, every neighbor visited (v) or an
+    # v v v v #             obstacle (#)
+    # v D v v .          .  unvisited: the search stops at the first
+    # v v v v #             one it reaches
+    # # # # # #
+                         route: (3,2) (4,2) (5,2)
+
+Neighbors come from the terrain's own neighborhood (see
+passable_neighbors()), so routes are shortest paths in the moves the
+drone can actually make, and ties are broken by the direction-table
+order: the same terrain always gives the same route.
+
+One search object is reused for every search of a thread (or of a
+drone, in ThreadPerDrone mode). Its buffers are sized on the first
+search, 3 bytes per cell:
+
+    seen_     uint16  generation stamp: reached by the current search
+    parent_   uint8   move that reached the cell, as its slot in the
+                      3x3 block (every neighborhood stays inside it)
+
+plus the queue (4 bytes per cell reached). On a 1000 x 1000 map that
+is 3 MB per search object, allocated only once a drone gets stuck.
+The stamps mean a search costs the cells it reaches, not a clear of
+the whole map.
+
+Works on any terrain type with in_bounds(), width(), cell_count(),
+passable_neighbors() and cell_at().
+*/
+class FrontierSearch {
+public:
+    /*
+    Fills `route` (see FrontierRoute) with the path from `start` to the
+    nearest unvisited cell, `start` itself excluded. Returns false, and
+    leaves `route` empty, when no unvisited cell is reachable.
+    */
+    template <typename TerrainType>
+    bool find_route(const TerrainType& terrain,
+                    const Position& start,
+                    FrontierRoute& route)
+    {
+        route.clear();
+
+        if (!terrain.in_bounds(start)) {
+            return false;
+        }
+
+        begin_search(terrain.cell_count());
+
+        const std::size_t width = static_cast<std::size_t>(terrain.width());
+
+        const auto index_of = [width](const Position& pos) {
+            return static_cast<std::uint32_t>(
+                static_cast<std::size_t>(pos.y) * width +
+                static_cast<std::size_t>(pos.x)
+            );
+        };
+
+        const auto position_of = [width](std::uint32_t cell) {
+            return Position{
+                static_cast<int>(cell % width),
+                static_cast<int>(cell / width)
+            };
+        };
+
+        seen_[index_of(start)] = generation_;
+        queue_.push_back(index_of(start));
+
+        for (std::size_t head = 0; head < queue_.size(); ++head) {
+            const Position from = position_of(queue_[head]);
+
+            for (const auto& next : terrain.passable_neighbors(from)) {
+                const std::uint32_t next_cell = index_of(next);
+
+                if (seen_[next_cell] == generation_) {
+                    continue;
+                }
+
+                seen_[next_cell] = generation_;
+                parent_[next_cell] = static_cast<std::uint8_t>(
+                    (next.y - from.y + 1) * 3 + (next.x - from.x + 1)
+                );
+
+                if (!terrain.cell_at(next).visited) {
+                    // Walk back to the drone, then put the route in
+                    // flying order.
+                    for (Position step = next; !(step == start);) {
+                        route.cells.push_back(step);
+
+                        const int move = parent_[index_of(step)];
+
+                        step = Position{
+                            step.x - (move % 3 - 1),
+                            step.y - (move / 3 - 1)
+                        };
+                    }
+
+                    std::reverse(route.cells.begin(), route.cells.end());
+                    return true;
+                }
+
+                queue_.push_back(next_cell);
+            }
+        }
+
+        return false;
+    }
+
+private:
+    void begin_search(std::size_t cell_count) {
+        if (seen_.size() != cell_count) {
+            seen_.assign(cell_count, 0);
+            parent_.assign(cell_count, 0);
+            generation_ = 0;
+        }
+
+        ++generation_;
+
+        // After 2^16 searches the stamps wrap: start over once.
+        if (generation_ == 0) {
+            std::fill(seen_.begin(), seen_.end(), 0);
+            generation_ = 1;
+        }
+
+        queue_.clear();
+    }
+
+    // seen_[cell] == generation_: reached by the current search.
+    std::vector<std::uint16_t> seen_;
+    std::vector<std::uint8_t> parent_;
+    std::vector<std::uint32_t> queue_;
+    std::uint16_t generation_{0};
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/*
+FIFO of at most `capacity` values between threads.
+
+    producer ──► push()   waits while the queue is full
+    consumer ◄── pop()    waits while the queue is empty
+
+close() ends the hand-over: push() refuses new values, pop() returns
+what is left and then reports the end. Either side may close, so a
+consumer that fails can release a producer waiting on a full queue.
+
+The bound is what keeps a slow consumer (a disk, an encoder) from
+growing memory without limit: the producer waits instead.
+*/
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity)
+        : capacity_(capacity == 0 ? 1 : capacity)
+    {
+    }
+
+    std::size_t capacity() const {
+        return capacity_;
+    }
+
+    // Returns false, and drops `value`, once the queue is closed.
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        not_full_.wait(lock, [this]() {
+            return closed_ || values_.size() < capacity_;
+        });
+
+        if (closed_) {
+            return false;
+        }
+
+        values_.push_back(std::move(value));
+        not_empty_.notify_one();
+
+        return true;
+    }
+
+    // Returns false when the queue is closed and drained.
+    bool pop(T& value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        not_empty_.wait(lock, [this]() {
+            return closed_ || !values_.empty();
+        });
+
+        if (values_.empty()) {
+            return false;
+        }
+
+        value = std::move(values_.front());
+        values_.pop_front();
+        not_full_.notify_one();
+
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return values_.size();
+    }
+
+private:
+    std::size_t capacity_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+
+    std::deque<T> values_;
+    bool closed_{false};
+};
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "aeroswarm/live/texel_grid.hpp"
+#include "aeroswarm/types.hpp"
+
+/*
+Level-of-detail counts for a zoomed-out map view.
+
+Level l splits the map into blocks of 2^l x 2^l cells and counts, per
+block, the obstacles and the visited cells in it:
+
+    level 0   cells (TexelGrid, not stored here)
+    level 1   2 x 2 blocks
+    level 2   4 x 4 blocks
+    ...
+    level 7   128 x 128 blocks (counts up to 16384 fit 16 bits)
+
+Counts are kept up to date one visit at a time (add_visited() touches
+one counter per level), so the zoomed-out picture never needs a pass
+over the map. fill() turns the blocks of a visible window into
+coverage-density texels: the free, visited and obstacle colors of
+TexelGrid, mixed by the share of each kind of cell in the block. A
+fully visited block therefore has exactly TexelGrid::visited_color.
+
+Memory: 2 layers x 2 bytes x (1/4 + 1/16 + ...) of the cell count,
+about 1.3 bytes per cell.
+*/
+class DensityPyramid {
+public:
+    static constexpr int max_level = 7;
+
+    DensityPyramid(int width, int height)
+        : width_(width),
+          height_(height)
+    {
+        const int longest = std::max(width, height);
+
+        while (level_count_ < max_level &&
+               (1 << (level_count_ + 1)) < longest) {
+            ++level_count_;
+        }
+
+        levels_.resize(static_cast<std::size_t>(level_count_) + 1);
+
+        for (int level = 1; level <= level_count_; ++level) {
+            Level& counts = levels_[static_cast<std::size_t>(level)];
+
+            counts.width = blocks(width_, level);
+            counts.height = blocks(height_, level);
+
+            const std::size_t size =
+                static_cast<std::size_t>(counts.width) * counts.height;
+
+            counts.obstacles.assign(size, 0);
+            counts.visited.assign(size, 0);
+        }
+    }
+
+    // Levels 1..level_count() exist; 0 when the map is tiny.
+    int level_count() const {
+        return level_count_;
+    }
+
+    // Blocks per row / column at `level`.
+    int level_width(int level) const {
+        return levels_[static_cast<std::size_t>(level)].width;
+    }
+
+    int level_height(int level) const {
+        return levels_[static_cast<std::size_t>(level)].height;
+    }
+
+    // Changes on every update; equal versions mean equal counts.
+    std::uint64_t version() const {
+        return version_;
+    }
+
+    void set_obstacles(const std::vector<Position>& obstacles) {
+        for (int level = 1; level <= level_count_; ++level) {
+            auto& counts = levels_[static_cast<std::size_t>(level)].obstacles;
+            std::fill(counts.begin(), counts.end(), 0);
+        }
+
+        for (const auto& pos : obstacles) {
+            if (in_bounds(pos)) {
+                add(pos, &Level::obstacles);
+            }
+        }
+
+        ++version_;
+    }
+
+    void clear_visited() {
+        for (int level = 1; level <= level_count_; ++level) {
+            auto& counts = levels_[static_cast<std::size_t>(level)].visited;
+            std::fill(counts.begin(), counts.end(), 0);
+        }
+
+        ++version_;
+    }
+
+    // Call once per newly visited cell (see TexelGrid::mark_visited()).
+    void add_visited(const Position& pos) {
+        if (!in_bounds(pos)) {
+            return;
+        }
+
+        add(pos, &Level::visited);
+        ++version_;
+    }
+
+    std::uint16_t visited_count(int level, int block_x, int block_y) const {
+        const Level& counts = levels_[static_cast<std::size_t>(level)];
+        return counts.visited[index(counts, block_x, block_y)];
+    }
+
+    std::uint16_t obstacle_count(int level, int block_x, int block_y) const {
+        const Level& counts = levels_[static_cast<std::size_t>(level)];
+        return counts.obstacles[index(counts, block_x, block_y)];
+    }
+
+    // Density texel (0xRRGGBBAA) of one block.
+    std::uint32_t texel_at(int level, int block_x, int block_y) const {
+        const int size = 1 << level;
+
+        // Edge blocks only partly cover the map.
+        const int cells_x =
+            std::min(size, width_ - block_x * size);
+        const int cells_y =
+            std::min(size, height_ - block_y * size);
+
+        const std::uint32_t area =
+            static_cast<std::uint32_t>(cells_x) *
+            static_cast<std::uint32_t>(cells_y);
+
+        const std::uint32_t obstacles =
+            obstacle_count(level, block_x, block_y);
+        const std::uint32_t visited =
+            visited_count(level, block_x, block_y);
+        const std::uint32_t free =
+            area - std::min(area, obstacles + visited);
+
+        const std::uint32_t total = free + visited + obstacles;
+
+        std::uint32_t texel = 0xffu;
+
+        for (unsigned shift = 8; shift < 32; shift += 8) {
+            const std::uint32_t mixed =
+                (channel(TexelGrid::free_color, shift) * free +
+                 channel(TexelGrid::visited_color, shift) * visited +
+                 channel(TexelGrid::obstacle_color, shift) * obstacles +
+                 total / 2) / total;
+
+            texel |= mixed << shift;
+        }
+
+        return texel;
+    }
+
+    /*
+    Writes the texels of blocks [block_x, block_x + columns) x
+    [block_y, block_y + rows) of `level` into `pixels`, `pitch` bytes
+    apart. The window must lie inside the level.
+    */
+    void fill(int level,
+              int block_x,
+              int block_y,
+              int columns,
+              int rows,
+              void* pixels,
+              int pitch) const
+    {
+        auto* bytes = static_cast<unsigned char*>(pixels);
+
+        for (int row = 0; row < rows; ++row) {
+            auto* out = bytes + static_cast<std::ptrdiff_t>(row) * pitch;
+
+            for (int column = 0; column < columns; ++column) {
+                const std::uint32_t texel =
+                    texel_at(level, block_x + column, block_y + row);
+
+                std::memcpy(
+                    out + column * sizeof(std::uint32_t),
+                    &texel,
+                    sizeof(texel)
+                );
+            }
+        }
+    }
+
+private:
+    struct Level {
+        int width{0};
+        int height{0};
+        std::vector<std::uint16_t> obstacles;
+        std::vector<std::uint16_t> visited;
+    };
+
+    static int blocks(int cells, int level) {
+        return (cells + (1 << level) - 1) >> level;
+    }
+
+    static std::uint32_t channel(std::uint32_t color, unsigned shift) {
+        return (color >> shift) & 0xffu;
+    }
+
+    static std::size_t index(const Level& counts, int block_x, int block_y) {
+        return static_cast<std::size_t>(block_y) * counts.width + block_x;
+    }
+
+    bool in_bounds(const Position& pos) const {
+        return pos.x >= 0 && pos.y >= 0 &&
+               pos.x < width_ && pos.y < height_;
+    }
+
+    void add(const Position& pos, std::vector<std::uint16_t> Level::*layer) {
+        for (int level = 1; level <= level_count_; ++level) {
+            Level& counts = levels_[static_cast<std::size_t>(level)];
+
+            ++(counts.*layer)[index(counts, pos.x >> level, pos.y >> level)];
+        }
+    }
+
+    int width_;
+    int height_;
+    int level_count_{0};
+
+    // levels_[0] is unused: level 0 is the cells themselves.
+    std::vector<Level> levels_;
+
+    std::uint64_t version_{0};
+};
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "aeroswarm/live/bounded_queue.hpp"
+#include "aeroswarm/live/simulation_snapshot.hpp"
+#include "aeroswarm/live/texel_grid.hpp"
+
+/*
+Headless recording: snapshots to files or to an encoder, without SDL.
+
+    simulation ──► triple buffer ──► record loop ──► BoundedQueue ──► writer thread
+     (workers)     (publisher)       record()                        raster + sink
+
+The simulation only ever publishes into its triple buffer, so it never
+waits for the recorder. The record loop samples the newest snapshot
+and queues it; rasterizing, encoding and disk writes all happen on the
+writer thread. When the writer falls behind, record() waits on the
+full queue and the next sample simply carries a longer visited delta:
+nothing is lost from the binary stream, image sinks get fewer frames.
+
+Sinks (any class with write(frame, raster) and finish()):
+
+    StreamFrameSink   compact binary stream, deltas only (see below)
+    PpmFrameSink      one binary PPM image per frame
+    PipeFrameSink     raw RGB24 frames into an encoder's stdin
+*/
+
+
+/*
+Image of the current frame, in the SdlRenderer colors:
+cell_size x cell_size pixels per cell, RGB24, row-major.
+
+Cells are kept in a TexelGrid; only the tiles changed by new visits
+or obstacles are redrawn into the cached base image. Each pixels()
+call copies the base and paints the target and the drones on top.
+*/
+class FrameRaster {
+public:
+    FrameRaster(int width, int height, int cell_size);
+
+    int image_width() const {
+        return width_ * cell_size_;
+    }
+
+    int image_height() const {
+        return height_ * cell_size_;
+    }
+
+    // Takes over the frame's state; its visited delta must continue
+    // the previous frame's (or start over at 0).
+    void apply(const SimulationSnapshot& frame);
+
+    // image_width() * image_height() * 3 bytes.
+    const std::vector<std::uint8_t>& pixels();
+
+private:
+    void update_base();
+    void paint(const Position& pos, float inset, std::uint32_t color);
+
+    int width_;
+    int height_;
+    int cell_size_;
+
+    TexelGrid cells_;
+    SharedPositions obstacles_;
+    std::optional<Position> target_;
+    std::vector<Position> drones_;
+
+    std::vector<std::uint8_t> base_;
+    std::vector<std::uint8_t> image_;
+    std::vector<std::uint32_t> tile_;
+};
+
+
+/*
+Binary frame stream, all integers little-endian:
+
+    header   "ASWF"  u32 version (1)  u32 width  u32 height
+
+    frame    u64 tick
+             u8  flags     1 target found       8 visited reset
+                           2 has target        16 obstacles follow
+                           4 has winner
+             [i32 x, i32 y]             target, if flag 2
+             [i32 id, u64 tick]         winner and winning tick, if 4
+             [u32 n, n x u32 cell]      obstacles, if 16
+             u32 n, n x u32 cell        visited since the last frame
+             u32 n, n x u32 cell        drone positions
+
+Cells are y * width + x. Obstacles are written with the first frame
+and again only when the list changes, so a frame costs about 4 bytes
+per newly visited cell and per drone.
+*/
+class StreamFrameSink {
+public:
+    StreamFrameSink(std::ostream& out, int width, int height);
+
+    void write(const SimulationSnapshot& frame, FrameRaster& raster);
+    void finish();
+
+private:
+    std::ostream* out_;
+    int width_;
+    SharedPositions obstacles_;
+    bool first_frame_{true};
+};
+
+
+/*
+Reads a StreamFrameSink stream back, one frame at a time. Each frame
+comes out as a delta snapshot (visited_epoch_begin .. visited_epoch),
+with the obstacle list as of that frame.
+
+Throws std::runtime_error on a malformed stream.
+*/
+class FrameStreamReader {
+public:
+    explicit FrameStreamReader(std::istream& in);
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    // False at the end of the stream.
+    bool next(SimulationSnapshot& frame);
+
+private:
+    std::istream* in_;
+    int width_{0};
+    int height_{0};
+    std::size_t visited_epoch_{0};
+    SharedPositions obstacles_;
+};
+
+
+// directory/frame_000000.ppm, frame_000001.ppm, ... (binary P6).
+class PpmFrameSink {
+public:
+    // Creates `directory` if needed.
+    explicit PpmFrameSink(std::string directory);
+
+    void write(const SimulationSnapshot& frame, FrameRaster& raster);
+
+    void finish() {
+    }
+
+private:
+    std::string directory_;
+    std::size_t next_frame_{0};
+};
+
+
+/*
+Raw RGB24 frames written to the stdin of `command`, run through the
+shell, e.g.
+
+    ffmpeg -y -f rawvideo -pix_fmt rgb24 -s 600x600 -r 60 -i - run.mp4
+
+finish() waits for the command and throws if it failed. SIGPIPE is
+ignored from construction on, so an encoder that exits early makes
+write() or finish() throw instead of ending the process.
+*/
+class PipeFrameSink {
+public:
+    explicit PipeFrameSink(const std::string& command);
+
+    void write(const SimulationSnapshot& frame, FrameRaster& raster);
+    void finish();
+
+private:
+    struct Closer {
+        void operator()(std::FILE* pipe) const;
+    };
+
+    std::unique_ptr<std::FILE, Closer> pipe_;
+};
+
+
+/*
+Owns the writer thread and the queue in front of it (see the top of
+this file). record() is called by one producer thread; frames are
+written in order.
+*/
+template <typename Sink>
+class FrameRecorder {
+public:
+    FrameRecorder(int width,
+                  int height,
+                  int cell_size,
+                  Sink sink,
+                  std::size_t queue_capacity = 8)
+        : raster_(width, height, cell_size),
+          sink_(std::move(sink)),
+          queue_(queue_capacity),
+          writer_([this]() { write_frames(); })
+    {
+    }
+
+    // Without finish(), queued frames are still written, but errors
+    // and the sink's own finish() are skipped.
+    ~FrameRecorder() {
+        if (writer_.joinable()) {
+            queue_.close();
+            writer_.join();
+        }
+    }
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    /*
+    Queues one frame, waiting while queue_capacity frames are pending.
+    A visited delta that does not continue the previous frame is
+    dropped (pass visited_epoch() to snapshot() to avoid that).
+    Rethrows the writer's error if it has failed.
+    */
+    void record(SimulationSnapshot frame) {
+        if (frame.visited_epoch_begin != 0 &&
+            frame.visited_epoch_begin != queued_epoch_) {
+            frame.visited_cells.clear();
+            frame.visited_epoch_begin = queued_epoch_;
+            frame.visited_epoch = queued_epoch_;
+        }
+
+        queued_epoch_ = frame.visited_epoch;
+
+        if (!queue_.push(std::move(frame))) {
+            throw_writer_error();
+        }
+    }
+
+    // Pass this to snapshot() to receive only the new visited cells.
+    std::size_t visited_epoch() const {
+        return queued_epoch_;
+    }
+
+    std::size_t frames_written() const {
+        return frames_written_.load(std::memory_order_acquire);
+    }
+
+    // Writes what is queued, stops the writer and finishes the sink.
+    void finish() {
+        if (!writer_.joinable()) {
+            return;
+        }
+
+        queue_.close();
+        writer_.join();
+
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+
+        sink_.finish();
+    }
+
+private:
+    void write_frames() {
+        SimulationSnapshot frame;
+
+        try {
+            while (queue_.pop(frame)) {
+                raster_.apply(frame);
+                sink_.write(frame, raster_);
+
+                frames_written_.fetch_add(1, std::memory_order_release);
+            }
+        } catch (...) {
+            // Published to the producer by close() (queue mutex).
+            error_ = std::current_exception();
+            queue_.close();
+        }
+    }
+
+    [[noreturn]] void throw_writer_error() {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+
+        throw std::runtime_error("Frame recorder is finished");
+    }
+
+    // Writer thread only.
+    FrameRaster raster_;
+    Sink sink_;
+
+    BoundedQueue<SimulationSnapshot> queue_;
+
+    // Producer thread only.
+    std::size_t queued_epoch_{0};
+
+    std::atomic<std::size_t> frames_written_{0};
+    std::exception_ptr error_;
+
+    // Last: starts once everything above is constructed.
+    std::thread writer_;
+};
@@ -1,19 +1,77 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "aeroswarm/live/density_pyramid.hpp"
 #include "aeroswarm/live/simulation_snapshot.hpp"
-
-#include <string>
+#include "aeroswarm/live/texel_grid.hpp"
 
 struct TTF_Font;
+struct SDL_FRect;
+struct SDL_Texture;
+struct SDL_Vertex;
+
+
+/*
+Cost of the frames drawn so far, for the end-of-run report.
+
+draw_calls counts SDL draw submissions (fill/line batches, texture
+copies, text) of the last frame, not the cells drawn: with the batched
+layers it stays constant, whatever the number of visited cells.
+*/
+struct RenderStats {
+    std::size_t frames{0};
+    double render_seconds{0.0};
+
+    std::size_t draw_calls{0};
+    std::size_t visited_cells{0};
+
+    double mean_frame_ms() const {
+        return frames == 0
+            ? 0.0
+            : render_seconds * 1.0e3 / static_cast<double>(frames);
+    }
+};
+
+/*
+How the map is drawn.
+
+    Cells    one cell_size x cell_size rectangle per visited cell and
+             obstacle, with grid lines. Cost grows with the visited
+             count; for maps that fit the screen at cell_size.
+
+    Texels   one texel per cell in a streaming texture, scaled to at
+             most max_texel_map_pixels on the longer side. Only the
+             tiles touched by newly visited cells are uploaded (see
+             TexelGrid), so a frame costs the cells that changed, not
+             the map area. No grid lines; drones and the target are
+             drawn on top, at least a few pixels wide. Zoomed out
+             below one pixel per cell, the view shows coverage density
+             from a DensityPyramid instead.
+
+Both modes pan and zoom (see process_events()).
+*/
+enum class SdlRenderMode {
+    Cells,
+    Texels
+};
+
 
 class SdlRenderer {
 public:
+    static constexpr int max_texel_map_pixels = 1024;
+
     SdlRenderer(
         int grid_width,
         int grid_height,
-        int cell_size = 20
+        int cell_size = 20,
+        SdlRenderMode mode = SdlRenderMode::Cells
     );
 
     ~SdlRenderer();
@@ -22,41 +80,239 @@ public:
     SdlRenderer(const SdlRenderer&) = delete;
     SdlRenderer& operator=(const SdlRenderer&) = delete;
 
-    // Process window events.
-    // Returns false when the user closes the window.
+    /*
+    Process window events.
+    Returns false when the user closes the window.
+
+    View controls, over the map area:
+
+        mouse wheel, + / -     zoom in / out (around the cursor for
+                               the wheel, the view center for keys)
+        drag (left or middle)  pan
+        arrow keys             pan
+        0                      whole map again
+    */
     bool process_events();
 
     // Render one immutable simulation snapshot.
+    //
+    // The snapshot only carries the visited cells added since
+    // visited_epoch(); the renderer keeps the accumulated layer itself.
     void render(const SimulationSnapshot& snapshot);
 
+    // Pass this to snapshot() to receive only the new visited cells.
+    std::size_t visited_epoch() const {
+        return visited_epoch_;
+    }
+
+    const RenderStats& stats() const {
+        return stats_;
+    }
+
 private:
     static constexpr int telemetry_width_ = 280;
 
     int grid_width_;
     int grid_height_;
     int cell_size_;
+    SdlRenderMode mode_;
+
+    // Size of one cell with the whole map in view, and of the map
+    // area of the window, in pixels.
+    float cell_pixels_;
+    int map_width_;
+    int map_height_;
+
+    /*
+    Viewport: the map area shows the cells from (view_x_, view_y_)
+    on, zoom_ pixels per cell. zoom_ ranges from cell_pixels_ (whole
+    map) to max_zoom_.
+    */
+    float zoom_;
+    float max_zoom_;
+    float view_x_{0.0f};
+    float view_y_{0.0f};
+    bool dragging_{false};
+
+    // Visible part of the map, in cells.
+    struct CellWindow {
+        float x{0.0f};
+        float y{0.0f};
+        float width{0.0f};
+        float height{0.0f};
+    };
+
+    CellWindow visible_cells() const;
+
+    void zoom_at(float factor, float screen_x, float screen_y);
+    void pan(float dx, float dy);
+    void clamp_view();
+
+    // Where cell (0, 0) lands and how large cells are, in pixels.
+    struct CellLayout {
+        float origin_x{0.0f};
+        float origin_y{0.0f};
+        float cell_pixels{1.0f};
+    };
+
+    // The viewport on screen, or the unscrolled static layer texture.
+    CellLayout screen_layout() const;
+    CellLayout texture_layout() const;
+
+    // Accumulated visited layer, extended from snapshot deltas.
+    std::vector<Position> visited_cells_;
+    std::size_t visited_epoch_{0};
 
     struct SDL_Window* window_{nullptr};
     struct SDL_Renderer* renderer_{nullptr};
 
-    void draw_grid();
-    void draw_cell(const Position& pos);
-    void draw_obstacle(const Position& pos);
-    void draw_target(const Position& pos);
-    void draw_drone(const Position& pos);
-    void draw_visited(const Position& pos);
+    /*
+    Grid lines and obstacles, drawn once into a render-target texture
+    and copied to the screen every frame. Rebuilt when the snapshot
+    carries a different obstacle list (the terrain publishes a new one
+    on every set_obstacle()), or when the GPU loses target contents.
+
+    Stays null when the map is too large for one texture; the static
+    layer is then drawn directly every frame, still batched.
+    */
+    SDL_Texture* static_layer_{nullptr};
+    SharedPositions static_layer_obstacles_;
+    bool static_layer_valid_{false};
+
+    /*
+    Texels mode: the map texture and its CPU-side state. The visited
+    delta goes straight into texels_; visited_cells_ stays empty.
+    */
+    SDL_Texture* cell_texture_{nullptr};
+    std::optional<TexelGrid> texels_;
+    SharedPositions texel_obstacles_;
+
+    void update_cell_texture(const SharedPositions& obstacles);
+
+    /*
+    Texels mode, zoomed out: density texels of the visible blocks of
+    one pyramid level, at most one per pixel of the map area. Rebuilt
+    only when the window, the level or the counts changed.
+    */
+    std::optional<DensityPyramid> pyramid_;
+    SDL_Texture* lod_texture_{nullptr};
+
+    struct LodWindow {
+        int level{0};
+        int block_x{0};
+        int block_y{0};
+        int columns{0};
+        int rows{0};
+        std::uint64_t version{0};
+
+        bool operator==(const LodWindow& other) const {
+            return level == other.level &&
+                   block_x == other.block_x &&
+                   block_y == other.block_y &&
+                   columns == other.columns &&
+                   rows == other.rows &&
+                   version == other.version;
+        }
+    };
+
+    LodWindow lod_window_;
+    bool lod_valid_{false};
+
+    // 0: cells (texels) are large enough; otherwise the pyramid level.
+    int lod_level() const;
+
+    void draw_texel_map();
+
+    // Reused between frames: one batch of rectangles per layer.
+    std::vector<SDL_FRect> rects_;
+
+    RenderStats stats_;
+
+    void update_static_layer(const SharedPositions& obstacles);
+
+    void draw_static_layer(
+        const SharedPositions& obstacles,
+        const CellLayout& layout
+    );
+
+    void draw_grid(const CellLayout& layout);
+
+    // Rectangle of a cell, shrunk by `inset` (a fraction of the cell
+    // size) on each side, but at least min_extent pixels wide.
+    SDL_FRect cell_rect(
+        const CellLayout& layout,
+        const Position& pos,
+        float inset,
+        float min_extent
+    ) const;
+
+    // Fills one rectangle per cell with a single SDL call.
+    void draw_cells(
+        const CellLayout& layout,
+        const std::vector<Position>& cells,
+        float inset = 0.0f,
+        float min_extent = 0.0f
+    );
 
     void draw_telemetry_panel();
 
 
     TTF_Font* font_{nullptr};
 
+    /*
+    Telemetry text without per-frame rasterization:
+
+        glyph atlas    printable ASCII rendered once into one texture;
+                       text that changes (numbers) is laid out as one
+                       quad per character, and all quads of a frame go
+                       out in one SDL_RenderGeometry call (flush_text)
+        label cache    fixed strings ("STATUS", "SEARCHING", ...)
+                       rendered once with kerning, one texture each
+    */
+    struct Glyph {
+        float x{0.0f};
+        float width{0.0f};
+        float advance{0.0f};
+    };
+
+    static constexpr char first_glyph_ = ' ';
+    static constexpr char last_glyph_ = '~';
+
+    SDL_Texture* glyph_atlas_{nullptr};
+    std::array<Glyph, last_glyph_ - first_glyph_ + 1> glyphs_{};
+    float atlas_width_{0.0f};
+    float atlas_height_{0.0f};
+
+    // Quads queued by draw_text() until flush_text().
+    std::vector<SDL_Vertex> text_vertices_;
+    std::vector<int> text_indices_;
+
+    struct Label {
+        SDL_Texture* texture{nullptr};
+        float width{0.0f};
+        float height{0.0f};
+    };
+
+    std::unordered_map<std::string, Label> labels_;
+
+    bool build_glyph_atlas();
+
+    // Text that changes between frames, from atlas quads.
     void draw_text(
         const std::string& text,
         float x,
         float y
     );
 
+    void flush_text();
+
+    // Text from a small fixed set, cached on first use.
+    void draw_label(
+        const std::string& text,
+        float x,
+        float y
+    );
+
     void draw_telemetry(
         const SimulationSnapshot& snapshot
     );
@@ -1,20 +1,39 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <vector>
-#include <optional>
 #include "aeroswarm/types.hpp"
 
 struct SimulationSnapshot {
     std::vector<Position> drone_positions;
+
+    /*
+    Visited cells are delivered incrementally.
+
+    visited_cells holds the journal entries
+    [visited_epoch_begin, visited_epoch): the cells visited since the
+    epoch the consumer passed to snapshot(). A consumer keeps its own
+    accumulated copy and passes snapshot.visited_epoch back next time.
+
+    snapshot(0) returns the full list. visited_epoch is also the total
+    number of visited cells.
+    */
     std::vector<Position> visited_cells;
-    std::vector<Position> obstacle_positions;
+    std::size_t visited_epoch_begin{0};
+    std::size_t visited_epoch{0};
+
+    // Static layer: shared with the terrain, never copied per snapshot.
+    // May be null when the producer has no terrain attached.
+    SharedPositions obstacle_positions;
     std::optional<Position> target;
 
     //Position target{};
 
     bool target_found{false};
     std::optional<int> winning_drone_id;
+    // Tick at which the winning drone reached the target.
+    std::optional<std::size_t> winning_tick;
 
     std::size_t tick{0};
 };
\ No newline at end of file
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "aeroswarm/bitboard.hpp"
+#include "aeroswarm/types.hpp"
+
+/*
+A tile of the map, in cells: [x, x + width) x [y, y + height).
+*/
+struct TexelTile {
+    int x{0};
+    int y{0};
+    int width{0};
+    int height{0};
+};
+
+
+/*
+CPU side of the one-texel-per-cell map texture (SdlRenderMode::Texels).
+
+Keeps the obstacle and visited layers as bitplanes (2 bits per cell,
+so an 8192 x 8192 map costs 16 MiB here) and remembers which
+tile_size x tile_size tiles changed since the last upload:
+
+    +------+------+------+
+    |      |  *   |      |     * cells visited since the last frame
+    +------+------+------+
+    |      |      | *  * |     only the two marked tiles are uploaded
+    +------+------+------+
+
+take_dirty_tiles() hands out the changed tiles once, and fill() writes
+the texels of a tile; an upload therefore costs the tiles touched by
+the newly visited cells, not the whole map.
+
+Texels are 32-bit 0xRRGGBBAA values (SDL_PIXELFORMAT_RGBA8888).
+No SDL dependency, so the bookkeeping is testable on its own.
+*/
+class TexelGrid {
+public:
+    static constexpr int tile_size = 64;
+
+    static constexpr std::uint32_t free_color = 0x191919ffu;
+    static constexpr std::uint32_t visited_color = 0x373741ffu;
+    static constexpr std::uint32_t obstacle_color = 0x6e5a46ffu;
+
+    TexelGrid(int width, int height)
+        : width_(width),
+          height_(height),
+          tiles_x_((width + tile_size - 1) / tile_size),
+          tiles_y_((height + tile_size - 1) / tile_size),
+          obstacles_(width, height, false),
+          visited_(width, height, false),
+          tile_dirty_(static_cast<std::size_t>(tiles_x_) * tiles_y_, 0)
+    {
+        mark_all_dirty();
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    // Replaces the obstacle layer. Redraws everything.
+    void set_obstacles(const std::vector<Position>& obstacles) {
+        obstacles_ = Bitboard{width_, height_, false};
+
+        for (const auto& pos : obstacles) {
+            if (in_bounds(pos)) {
+                obstacles_.set(pos);
+            }
+        }
+
+        mark_all_dirty();
+    }
+
+    // Forgets every visited cell. Redraws everything.
+    void clear_visited() {
+        visited_ = Bitboard{width_, height_, false};
+        mark_all_dirty();
+    }
+
+    // True when the cell was not visited before.
+    bool mark_visited(const Position& pos) {
+        if (!in_bounds(pos) || !visited_.set(pos)) {
+            return false;
+        }
+
+        mark_dirty(pos.x / tile_size, pos.y / tile_size);
+        return true;
+    }
+
+    bool visited(const Position& pos) const {
+        return visited_.test(pos, std::memory_order_relaxed);
+    }
+
+    // Uploads every tile again, e.g. into a new texture.
+    void mark_all_dirty() {
+        for (int tile_y = 0; tile_y < tiles_y_; ++tile_y) {
+            for (int tile_x = 0; tile_x < tiles_x_; ++tile_x) {
+                mark_dirty(tile_x, tile_y);
+            }
+        }
+    }
+
+    std::size_t dirty_tile_count() const {
+        return dirty_.size();
+    }
+
+    /*
+    Calls upload(tile) for every tile changed since the last call, then
+    forgets them.
+    */
+    template <typename Upload>
+    void take_dirty_tiles(Upload&& upload) {
+        for (const auto tile : dirty_) {
+            tile_dirty_[tile] = 0;
+
+            const int x = static_cast<int>(tile % tiles_x_) * tile_size;
+            const int y = static_cast<int>(tile / tiles_x_) * tile_size;
+
+            upload(TexelTile{
+                x,
+                y,
+                std::min(tile_size, width_ - x),
+                std::min(tile_size, height_ - y)
+            });
+        }
+
+        dirty_.clear();
+    }
+
+    /*
+    Writes the texels of `tile` into `pixels`, row by row, `pitch` bytes
+    apart (as returned by SDL_LockTexture).
+    */
+    void fill(const TexelTile& tile, void* pixels, int pitch) const {
+        auto* bytes = static_cast<unsigned char*>(pixels);
+
+        for (int row = 0; row < tile.height; ++row) {
+            auto* out = bytes + static_cast<std::ptrdiff_t>(row) * pitch;
+
+            for (int column = 0; column < tile.width; ++column) {
+                const std::uint32_t texel =
+                    texel_at({tile.x + column, tile.y + row});
+
+                std::memcpy(
+                    out + column * sizeof(std::uint32_t),
+                    &texel,
+                    sizeof(texel)
+                );
+            }
+        }
+    }
+
+    std::uint32_t texel_at(const Position& pos) const {
+        if (obstacles_.test(pos, std::memory_order_relaxed)) {
+            return obstacle_color;
+        }
+
+        return visited_.test(pos, std::memory_order_relaxed)
+            ? visited_color
+            : free_color;
+    }
+
+private:
+    bool in_bounds(const Position& pos) const {
+        return pos.x >= 0 && pos.y >= 0 &&
+               pos.x < width_ && pos.y < height_;
+    }
+
+    void mark_dirty(int tile_x, int tile_y) {
+        const std::size_t tile =
+            static_cast<std::size_t>(tile_y) * tiles_x_ + tile_x;
+
+        if (tile_dirty_[tile] == 0) {
+            tile_dirty_[tile] = 1;
+            dirty_.push_back(static_cast<std::uint32_t>(tile));
+        }
+    }
+
+    int width_;
+    int height_;
+    int tiles_x_;
+    int tiles_y_;
+
+    Bitboard obstacles_;
+    Bitboard visited_;
+
+    // tile_dirty_[tile] != 0: tile is listed in dirty_.
+    std::vector<std::uint8_t> tile_dirty_;
+    std::vector<std::uint32_t> dirty_;
+};
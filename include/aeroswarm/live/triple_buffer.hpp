@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/*
+Wait-free hand-over of the latest value from ONE producer to ONE consumer.
+
+Three slots, each owned by exactly one party at any time:
+
+    producer ──► [ back ]      being written
+                 [ middle ]    latest complete value, owned by nobody
+    consumer ◄── [ front ]     being read
+
+publish():  the producer swaps back <-> middle in one atomic exchange
+            and marks middle as fresh.
+
+update():   if middle is fresh, the consumer swaps front <-> middle in
+            one atomic exchange.
+
+Neither side ever waits for the other:
+
+    - the producer can publish many times while the consumer reads one
+      frame (intermediate frames are simply overwritten),
+    - the consumer always reads a complete frame, never a half-written
+      one.
+
+state_ packs the middle slot index (bits 0-1) and the "fresh" flag (bit 2).
+*/
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side: the slot to fill before publish().
+    T& write_buffer() {
+        return slots_[back_];
+    }
+
+    // Producer side: make write_buffer() the latest complete value.
+    void publish() {
+        const std::uint8_t previous = state_.exchange(
+            static_cast<std::uint8_t>(back_ | fresh_bit),
+            std::memory_order_acq_rel
+        );
+
+        back_ = previous & index_mask;
+    }
+
+    // Consumer side: switch to the newest published value, if any.
+    // Returns true when read_buffer() changed.
+    bool update() {
+        if ((state_.load(std::memory_order_acquire) & fresh_bit) == 0) {
+            return false;
+        }
+
+        const std::uint8_t previous = state_.exchange(
+            front_,
+            std::memory_order_acq_rel
+        );
+
+        front_ = previous & index_mask;
+        return true;
+    }
+
+    // Consumer side: the value selected by the last update().
+    const T& read_buffer() const {
+        return slots_[front_];
+    }
+
+private:
+    static constexpr std::uint8_t index_mask = 0b011;
+    static constexpr std::uint8_t fresh_bit = 0b100;
+
+    std::array<T, 3> slots_{};
+
+    // back_ is only touched by the producer, front_ only by the consumer.
+    std::uint8_t back_{0};
+    std::atomic<std::uint8_t> state_{1};
+    std::uint8_t front_{2};
+};
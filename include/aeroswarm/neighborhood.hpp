@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "aeroswarm/types.hpp"
+
+/*
+Neighborhood policies: which cells count as neighbors of a cell.
+
+A terrain takes one as a template argument, so the direction table and
+the maximum number of neighbors are compile-time constants: loops over
+the directions fully unroll and result containers are sized exactly.
+
+    FourConnected         EightConnected        HexOffset
+                                                (odd rows shifted right)
+        .  N  .             NW  N  NE             even row     odd row
+        W  D  E             W   D  E               N  N .      . N  N
+        .  S  .             SW  S  SE              W  D E      W D  E
+                                                   S  S .      . S  S
+
+Every policy provides:
+
+    max_neighbors        size of the direction tables
+    offset_rows          true when odd rows use odd_row_directions
+    directions           (even rows) in the order neighbors are returned
+    odd_row_directions   same as directions unless offset_rows
+
+All offsets stay inside the 3x3 block around a cell, so the bitboard
+window lookups (see bitboard.hpp) work for every policy. Every policy is
+symmetric (b is a neighbor of a exactly when a is a neighbor of b),
+which is what lets a terrain update the information gain of a cell's
+neighbors when the cell itself changes.
+*/
+
+struct FourConnected {
+    static constexpr std::size_t max_neighbors = 4;
+    static constexpr bool offset_rows = false;
+
+    static constexpr std::array<Position, max_neighbors> directions{{
+        {1, 0}, {-1, 0}, {0, 1}, {0, -1}
+    }};
+
+    static constexpr std::array<Position, max_neighbors> odd_row_directions =
+        directions;
+};
+
+
+struct EightConnected {
+    static constexpr std::size_t max_neighbors = 8;
+    static constexpr bool offset_rows = false;
+
+    static constexpr std::array<Position, max_neighbors> directions{{
+        {0, 1}, {0, -1}, {1, 0}, {-1, 0},
+        {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+    }};
+
+    static constexpr std::array<Position, max_neighbors> odd_row_directions =
+        directions;
+};
+
+
+/*
+Hexagonal cells on a rectangular grid, "odd-r" offset layout: odd rows
+are drawn half a cell to the right, so the diagonal neighbors of an
+even-row cell lean west and those of an odd-row cell lean east.
+*/
+struct HexOffset {
+    static constexpr std::size_t max_neighbors = 6;
+    static constexpr bool offset_rows = true;
+
+    static constexpr std::array<Position, max_neighbors> directions{{
+        {1, 0}, {-1, 0}, {-1, -1}, {0, -1}, {-1, 1}, {0, 1}
+    }};
+
+    static constexpr std::array<Position, max_neighbors> odd_row_directions{{
+        {1, 0}, {-1, 0}, {0, -1}, {1, -1}, {0, 1}, {1, 1}
+    }};
+};
+
+
+// Direction table of the cells in row y.
+template <typename Neighborhood>
+constexpr const std::array<Position, Neighborhood::max_neighbors>&
+row_directions(int y)
+{
+    if constexpr (Neighborhood::offset_rows) {
+        if (y & 1) {
+            return Neighborhood::odd_row_directions;
+        }
+    }
+
+    (void)y;
+    return Neighborhood::directions;
+}
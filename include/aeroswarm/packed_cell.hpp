@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+#include "aeroswarm/types.hpp"
+
+/*
+One byte per terrain cell.
+
+The terrains used to store std::vector<std::vector<Cell>>:
+
+    grid_[x] ──► heap block ──► Cell Cell Cell ...
+    grid_[x+1] ──► another heap block ──► Cell Cell ...
+
+    - one allocation per column
+    - a pointer chase on every grid_[x][y]
+    - sizeof(Cell) == 8 (int-sized enum + padded bool)
+
+They now store ONE contiguous row-major buffer of PackedCell:
+
+    index = y * width + x
+
+    +----+----+----+----+----+----+----+----+
+    | y0 | y0 | y0 | y0 | y1 | y1 | y1 | y1 | ...
+    +----+----+----+----+----+----+----+----+
+
+The (x-1, x, x+1) neighbors of a cell are adjacent bytes, and the rows
+above and below are exactly `width` bytes away.
+
+Bit layout:
+
+    bit 0-1   CellType  (Free / Obstacle / Target)
+    bit 2     visited
+    bit 3-7   unused
+*/
+using PackedCell = std::uint8_t;
+
+constexpr PackedCell cell_type_mask = 0b0000'0011;
+constexpr PackedCell cell_visited_bit = 0b0000'0100;
+
+
+constexpr PackedCell pack_cell(CellType type, bool visited) {
+    return static_cast<PackedCell>(
+        static_cast<PackedCell>(type) |
+        (visited ? cell_visited_bit : 0)
+    );
+}
+
+constexpr CellType cell_type(PackedCell cell) {
+    return static_cast<CellType>(cell & cell_type_mask);
+}
+
+constexpr bool cell_visited(PackedCell cell) {
+    return (cell & cell_visited_bit) != 0;
+}
+
+constexpr bool cell_obstacle(PackedCell cell) {
+    return cell_type(cell) == CellType::Obstacle;
+}
+
+// Free or target, and not yet visited: a drone may move here.
+constexpr bool cell_available(PackedCell cell) {
+    return !cell_visited(cell) && !cell_obstacle(cell);
+}
+
+// Replace the type bits, keep the visited bit.
+constexpr PackedCell with_cell_type(PackedCell cell, CellType type) {
+    return static_cast<PackedCell>(
+        (cell & ~cell_type_mask) |
+        static_cast<PackedCell>(type)
+    );
+}
+
+constexpr Cell unpack_cell(PackedCell cell) {
+    return Cell{cell_type(cell), cell_visited(cell)};
+}
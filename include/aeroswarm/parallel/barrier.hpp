@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+/*
+Reusable thread barrier (C++17 stand-in for std::barrier).
+
+    thread 0 ──arrive_and_wait()──┐
+    thread 1 ──arrive_and_wait()──┼── last one runs on_completion(),
+    thread 2 ──arrive_and_wait()──┘   then everyone continues
+
+on_completion runs exactly once per phase, on the last arriving thread,
+while all the others are still blocked: it may touch state that the
+participants only read outside the barrier.
+
+The generation counter makes the barrier reusable: a thread that races
+ahead into the next phase cannot be mistaken for a late arrival of the
+previous one.
+*/
+class Barrier {
+public:
+    explicit Barrier(std::size_t participants,
+                     std::function<void()> on_completion = {})
+        : participants_(participants),
+          on_completion_(std::move(on_completion))
+    {
+    }
+
+    void arrive_and_wait() {
+        std::unique_lock<std::mutex> lock(mtx_);
+
+        const std::size_t generation = generation_;
+
+        if (++arrived_ == participants_) {
+            if (on_completion_) {
+                on_completion_();
+            }
+
+            arrived_ = 0;
+            ++generation_;
+
+            lock.unlock();
+            phase_done_.notify_all();
+            return;
+        }
+
+        phase_done_.wait(lock, [&]() {
+            return generation_ != generation;
+        });
+    }
+
+private:
+    std::mutex mtx_;
+    std::condition_variable phase_done_;
+
+    std::size_t participants_;
+    std::size_t arrived_{0};
+    std::size_t generation_{0};
+
+    std::function<void()> on_completion_;
+};
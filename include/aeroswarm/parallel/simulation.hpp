@@ -1,23 +1,82 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <optional>
 #include <thread>
 #include <random>
 #include <vector>
 #include <mutex>
-#include <shared_mutex>
+#include <memory>
 #include <chrono>
+#include <condition_variable>
 #include "aeroswarm/drone.hpp"
+#include "aeroswarm/frontier.hpp"
+#include "aeroswarm/stop_token.hpp"
 #include "aeroswarm/parallel/terrain.hpp"
+#include "aeroswarm/parallel/work_stealing.hpp"
 #include "aeroswarm/live/simulation_snapshot.hpp"
+#include "aeroswarm/live/triple_buffer.hpp"
 
 
 enum class ParallelSimulationStatus {
     TargetFound,
-    Stuck
+    Stuck,
+    Cancelled,          // the StopToken passed to run() was triggered
+    DeadlineExceeded    // the Deadline passed to run() has passed
 };
 
+
+/*
+How run() maps drones onto threads.
+
+    ThreadPerDrone   one std::thread per drone (the original model)
+
+    ThreadPool       worker_threads threads, each stepping many drones
+                     from its own queue and stealing from the others
+                     once its queue runs dry (see work_stealing.hpp)
+
+    Lockstep         worker_threads threads, bulk-synchronous rounds:
+                     all drones choose, conflicts are resolved by a
+                     seeded rotating priority, all winners commit.
+                     Deterministic for a given seed, independent of
+                     worker_threads and of OS scheduling. tick counts
+                     rounds instead of moves.
+*/
+enum class ParallelExecution {
+    ThreadPerDrone,
+    ThreadPool,
+    Lockstep
+};
+
+
+struct ParallelSimulationOptions {
+    // Pause between two moves of the same drone (0 = as fast as possible).
+    std::chrono::milliseconds update_interval{0};
+
+    /*
+    Snapshot publication (0 = off).
+
+    When set, run() starts a publisher thread that writes a snapshot into
+    a triple buffer every snapshot_interval. Consumers then call
+    latest_snapshot() instead of snapshot(), and never take a lock that
+    a drone worker also takes.
+    */
+    std::chrono::milliseconds snapshot_interval{0};
+
+    ParallelExecution execution{ParallelExecution::ThreadPerDrone};
+
+    // ThreadPool / Lockstep (0 = std::thread::hardware_concurrency()).
+    // Never more threads than drones.
+    std::size_t worker_threads{0};
+
+    // What a drone with no free neighbor does, see StuckRecovery. With
+    // SeekFrontier a drone only stops once no unvisited cell is
+    // reachable, and every cell flown over on the way counts as a move.
+    StuckRecovery recovery{StuckRecovery::Stop};
+};
+
+
 class ParallelSimulation {
     public:
         ParallelSimulation(ParallelTerrain& terrain,
@@ -26,11 +85,42 @@ class ParallelSimulation {
                             std::chrono::milliseconds update_interval =
                             std::chrono::milliseconds{0});
 
-        ParallelSimulationStatus run();
+        ParallelSimulation(ParallelTerrain& terrain,
+                            std::vector<Drone> drones,
+                            unsigned int seed,
+                            ParallelSimulationOptions options);
+
+        /*
+        Runs until the target is found, every drone is stuck, `stop` is
+        triggered or `deadline` passes, whichever comes first.
+
+        Workers poll the token (one relaxed load) and the deadline (one
+        clock read, only when set) on every move; a paced worker
+        notices within one update_interval.
+        */
+        ParallelSimulationStatus run(StopToken stop = {},
+                                     Deadline deadline = std::nullopt);
 
         bool target_found() const;
         std::optional<int> winning_drone_id() const;
-        SimulationSnapshot snapshot() const;
+        // Tick of the winning move (the round, in Lockstep mode).
+        std::optional<std::size_t> winning_tick() const;
+        // Visited cells since `visited_epoch` (0 = full list), see
+        // SimulationSnapshot::visited_cells.
+        SimulationSnapshot snapshot(std::size_t visited_epoch = 0) const;
+
+        /*
+        Latest published frame (requires options.snapshot_interval > 0,
+        otherwise this falls back to snapshot()).
+
+        Drone positions, tick, winner and target come from the newest
+        complete frame in the triple buffer. Visited cells since
+        `visited_epoch` are read from the terrain's lock-free journal, up
+        to the frame's own epoch.
+
+        Meant for one consumer thread (the renderer / monitor).
+        */
+        SimulationSnapshot latest_snapshot(std::size_t visited_epoch = 0) const;
 
 
     private:
@@ -39,23 +129,189 @@ class ParallelSimulation {
         Also, all drone workers must operate on the same shared terrain, not copies.
         */
         ParallelTerrain& terrain_; 
-        std::vector<Drone> drones_;
-        mutable std::shared_mutex drones_mutex_;
+        /*
+        Drone state, without a lock.
+
+        Ids never change after construction. Each position is a single
+        64-bit atomic (x in the low, y in the high 32 bits) on its own
+        cache line, so a worker moving its drone never invalidates the
+        line another worker is reading. Only the thread currently
+        stepping a drone writes its slot.
+        */
+        struct alignas(64) DronePosition {
+            std::atomic<std::uint64_t> packed{0};
+        };
+
+        std::vector<int> drone_ids_;
+        std::unique_ptr<DronePosition[]> positions_;
+
+        Position load_position(std::size_t drone_index) const;
+        void store_position(std::size_t drone_index, const Position& pos);
+
+        /*
+        Consistent reads of all positions (a seqlock, see
+        collect_positions()):
+
+            writer   begun + 1 ─ store position ─ done + 1
+            reader   d = done ─ read all ─ s = begun ─ valid if s == d
+
+        If a reader keeps losing against the writers, it raises
+        pending_readers_ and workers hold back new moves (one relaxed
+        load per move) until it has its copy.
+        */
+        std::atomic<std::size_t> position_writes_begun_{0};
+        std::atomic<std::size_t> position_writes_done_{0};
+        mutable std::atomic<int> pending_readers_{0};
+
+        void collect_positions(std::vector<Position>& out) const;
+
         unsigned int seed_;
 
         /*
-        Provides lock-free synchronization for many primitive data types.
-        Enables safe communication between multiple threads without explicit mutexes.
+        Winner slot: target found, winning drone and tick of the win in
+        one word, written once by a single compare-exchange.
+
+            bit 63        set once the target is found
+            bits 62..32   tick of the winning move (saturates at 2^31 - 1)
+            bits 31..0    drone id
+
+        Every reader (workers' stop check, winning_drone_id(),
+        snapshot()) is a single atomic load: nobody ever blocks.
+        */
+        std::atomic<std::uint64_t> winner_{0};
+
+        // False when someone else won first.
+        bool try_record_winner(int drone_id, std::size_t tick);
+
+
+        /*
+        Per-drone random engine.
+
+        The ThreadPool mode keeps one engine per drone alive for the
+        whole run, so it must stay small (minstd_rand: one word,
+        mt19937: 5 KB).
+        */
+        using DroneRng = std::minstd_rand;
+
+        enum class DroneStep {
+            Moved,
+            Blocked,        // lost the claim race, try again
+            Stuck,          // no free neighbor left
+            ReachedTarget
+        };
+
+        struct MoveChoice {
+            Position next;
+            bool is_target;
+
+            // False when flying over an already visited cell of a
+            // frontier route: nothing to claim.
+            bool claim{true};
+
+            // Taken from the drone's FrontierRoute: advance it once
+            // the move is committed.
+            bool from_route{false};
+        };
+
+        // Read-only half of a move: the cell the drone wants next
+        // (empty when it is boxed in).
+        std::optional<MoveChoice> choose_move(std::size_t drone_index,
+                                              DroneRng& rng) const;
+
+        /*
+        choose_move(), or the next cell of the drone's frontier route
+        (planned with `search` once the drone is boxed in, when
+        recovery_ is SeekFrontier). Read-only on the terrain; only
+        `route` is updated.
         */
-        // Shared stop flag safely read/written by multiple worker threads.
-        std::atomic<bool> target_found_{false};
-        // We'll discuss synchronization for this before implementing it.
-        std::optional<int> winning_drone_id_;
-        mutable std::mutex winner_mutex_;
+        std::optional<MoveChoice> plan_move(std::size_t drone_index,
+                                            DroneRng& rng,
+                                            FrontierRoute& route,
+                                            FrontierSearch& search) const;
+
+        // Next cell of an active route, claimed only at its end.
+        MoveChoice route_move(const FrontierRoute& route) const;
+
+        // Write half: move onto a cell the drone has already claimed,
+        // recording the winner (at `tick`) if it is the target.
+        DroneStep commit_move(std::size_t drone_index,
+                              const MoveChoice& choice,
+                              std::size_t tick);
 
+        // plan + claim + commit, for the free-running modes.
+        DroneStep step_drone(std::size_t drone_index,
+                             DroneRng& rng,
+                             FrontierRoute& route,
+                             FrontierSearch& search);
 
+        // ThreadPerDrone
         void worker(std::size_t drone_index);
+
+        // ThreadPool
+        struct DroneTask {
+            DroneRng rng;
+            std::chrono::steady_clock::time_point next_update;
+            FrontierRoute route;
+        };
+
+        std::size_t pool_threads() const;
+        void run_pool();
+        void pool_worker(std::size_t thread_index,
+                         WorkStealingQueues& queues,
+                         std::vector<DroneTask>& tasks,
+                         std::atomic<std::size_t>& active_drones);
+
+        // Lockstep
+        void run_lockstep();
+
+        // Stop request / deadline of the current run().
+        enum class StopReason : std::uint8_t {
+            None,
+            Cancelled,
+            DeadlineExceeded
+        };
+
+        StopToken stop_token_;
+        Deadline deadline_;
+        std::atomic<StopReason> stop_reason_{StopReason::None};
+
+        // False once the target is found or the run was interrupted.
+        bool keep_running();
+
+        // Successful moves, or completed rounds in Lockstep mode.
         std::atomic<std::size_t> tick_{0};
 
         std::chrono::milliseconds update_interval_;
+        ParallelExecution execution_;
+        std::size_t worker_threads_;
+        StuckRecovery recovery_;
+
+        /*
+        Snapshot publication, see latest_snapshot().
+
+            publisher thread ──► frames_.write_buffer() ──► publish()
+            consumer         ──► frames_.update() ──► read_buffer()
+
+        Published frames carry no visited cells, only the journal epoch
+        they correspond to.
+
+        frames_ is mutable because the consumer side (update) runs in the
+        const latest_snapshot(). consumer_mutex_ only keeps two consumers
+        from stepping on each other; workers never touch it.
+        */
+        std::chrono::milliseconds snapshot_interval_;
+        mutable TripleBuffer<SimulationSnapshot> frames_;
+        mutable std::mutex consumer_mutex_;
+
+        // Wakes the publisher as soon as the workers are joined instead
+        // of letting run() wait out the rest of an interval.
+        std::mutex publisher_mutex_;
+        std::condition_variable publisher_wakeup_;
+        bool workers_done_{false};
+
+        // Fill `out` reusing its vectors' capacity.
+        void fill_snapshot(SimulationSnapshot& out,
+                           std::size_t visited_epoch) const;
+        void publish_snapshot();
+        void publisher();
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+/*
+One task queue per pool thread, with stealing.
+
+    thread 0      thread 1      thread 2
+    [a b c d]     [e f]         [ ]        <- idle
+     ^     ^                     |
+     pop   steal <---------------+
+
+A thread pops tasks from the FRONT of its own queue and pushes
+unfinished tasks to the BACK again, so it cycles through its drones
+round-robin. A thread whose queue is empty steals from the BACK of
+another queue, away from where the owner is working.
+
+Tasks are plain indices (drone indices for ParallelSimulation).
+
+Each queue has its own mutex and sits on its own cache line, so the
+owner only contends with a thief, never with the other owners.
+
+A thread that finds nothing to pop or steal sleeps in wait_for_task()
+instead of spinning: push() wakes one sleeper, close() wakes them all.
+push() only touches the wait mutex when somebody is actually waiting.
+*/
+class WorkStealingQueues {
+public:
+    explicit WorkStealingQueues(std::size_t queue_count)
+        : queues_(std::make_unique<Queue[]>(queue_count)),
+          queue_count_(queue_count)
+    {
+    }
+
+    std::size_t size() const {
+        return queue_count_;
+    }
+
+    void push(std::size_t queue, std::size_t task) {
+        {
+            std::lock_guard<std::mutex> lock(queues_[queue].mtx);
+            queues_[queue].tasks.push_back(task);
+
+            // Under the queue mutex, so the pop of this task can never
+            // count down before it was counted up.
+            queued_.fetch_add(1);
+        }
+
+        // Pairs with wait_for_task(): either the waiter sees queued_ > 0
+        // before sleeping, or we see it waiting and wake it.
+        if (waiting_.load() > 0) {
+            std::lock_guard<std::mutex> lock(wait_mtx_);
+            wait_cv_.notify_one();
+        }
+    }
+
+    // Owner side.
+    std::optional<std::size_t> pop(std::size_t queue) {
+        std::lock_guard<std::mutex> lock(queues_[queue].mtx);
+
+        auto& tasks = queues_[queue].tasks;
+
+        if (tasks.empty()) {
+            return std::nullopt;
+        }
+
+        const std::size_t task = tasks.front();
+        tasks.pop_front();
+        queued_.fetch_sub(1);
+        return task;
+    }
+
+    // Thief side: scan the other queues, starting after our own.
+    std::optional<std::size_t> steal(std::size_t thief) {
+        for (std::size_t offset = 1; offset < queue_count_; ++offset) {
+            auto& victim = queues_[(thief + offset) % queue_count_];
+
+            std::lock_guard<std::mutex> lock(victim.mtx);
+
+            if (!victim.tasks.empty()) {
+                const std::size_t task = victim.tasks.back();
+                victim.tasks.pop_back();
+                queued_.fetch_sub(1);
+                return task;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    /*
+    Blocks until some queue holds a task (true; another thread may
+    still take it first, so pop / steal again) or close() was called
+    (false).
+    */
+    bool wait_for_task() {
+        std::unique_lock<std::mutex> lock(wait_mtx_);
+
+        waiting_.fetch_add(1);
+
+        wait_cv_.wait(lock, [this]() {
+            return closed_ || queued_.load() > 0;
+        });
+
+        waiting_.fetch_sub(1);
+
+        return !closed_;
+    }
+
+    // Wakes every wait_for_task(), now and later, with false.
+    void close() {
+        std::lock_guard<std::mutex> lock(wait_mtx_);
+        closed_ = true;
+        wait_cv_.notify_all();
+    }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mtx;
+        std::deque<std::size_t> tasks;
+    };
+
+    std::unique_ptr<Queue[]> queues_;
+    std::size_t queue_count_;
+
+    // Tasks in all queues. Sequentially consistent, with waiting_: see
+    // push().
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> waiting_{0};
+
+    std::mutex wait_mtx_;
+    std::condition_variable wait_cv_;
+    bool closed_{false};
+};
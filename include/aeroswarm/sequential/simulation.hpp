@@ -5,6 +5,8 @@
 #include <optional>
 
 #include "aeroswarm/drone.hpp"
+#include "aeroswarm/frontier.hpp"
+#include "aeroswarm/stop_token.hpp"
 #include "aeroswarm/sequential/terrain.hpp"
 #include "aeroswarm/live/simulation_snapshot.hpp"
 
@@ -12,7 +14,9 @@
 enum class SimulationStatus {
     Running,
     TargetFound,
-    Stuck
+    Stuck,
+    Cancelled,          // the StopToken passed to run_until_done() was triggered
+    DeadlineExceeded    // the Deadline passed to run_until_done() has passed
 };
 
 
@@ -29,20 +33,36 @@ deterministic simulation
 */
 class Simulation {
 public:
-    // Simulation can take ownership of its own copy/moved state
+    // Simulation can take ownership of its own copy/moved state.
+    // A copied terrain shares its static layer (obstacles, target) with
+    // the original, so only the visited bitmap is duplicated.
+    //
+    // `recovery` decides what a drone with no available neighbor does,
+    // see StuckRecovery.
     Simulation(Terrain terrain,
                std::vector<Drone> drones,
-               unsigned int seed);
+               unsigned int seed,
+               StuckRecovery recovery = StuckRecovery::Stop);
 
     bool step();
     const Terrain& terrain() const;
+
+    // Moves the terrain out once the run is over, e.g. to reset and
+    // reuse it for the next scenario. The simulation must not step
+    // afterwards.
+    Terrain release_terrain();
     const std::vector<Drone>& drones() const;
     bool target_found() const;
     //int winning_drone_id() const;
     const std::optional<int>& winning_drone_id() const;
+    std::size_t tick() const;
 
-    SimulationStatus run_until_done();
-    SimulationSnapshot snapshot() const;
+    // Checks `stop` and `deadline` before every step().
+    SimulationStatus run_until_done(StopToken stop = {},
+                                    Deadline deadline = std::nullopt);
+    // Visited cells since `visited_epoch` (0 = full list), see
+    // SimulationSnapshot::visited_cells.
+    SimulationSnapshot snapshot(std::size_t visited_epoch = 0) const;
 
 private:
     Terrain terrain_;
@@ -52,4 +72,13 @@ private:
     //int winning_drone_id_{-1};
     std::optional<int> winning_drone_id_;
     std::size_t tick_{0};
+
+    // SeekFrontier only: one route per drone (empty while exploring),
+    // one search reused for all of them.
+    StuckRecovery recovery_;
+    std::vector<FrontierRoute> routes_;
+    FrontierSearch search_;
+
+    // Next cell of drones_[drone_index], or nothing when it stays put.
+    std::optional<Position> next_position(std::size_t drone_index);
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+
+/*
+Cooperative cancellation (C++17 stand-in for std::stop_source /
+std::stop_token).
+
+    StopSource source;                    // owned by the caller (UI, batch job)
+    simulation.run(source.get_token());   // workers poll the token
+    ...
+    source.request_stop();                // from any thread
+
+The flag is one shared atomic<bool>: stop_requested() is a single
+relaxed load, cheap enough to poll on every drone move.
+
+A default-constructed StopToken has no source and never stops.
+*/
+class StopToken {
+public:
+    StopToken() = default;
+
+    bool stop_requested() const {
+        return state_ && state_->load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class StopSource;
+
+    explicit StopToken(std::shared_ptr<const std::atomic<bool>> state)
+        : state_(std::move(state))
+    {
+    }
+
+    std::shared_ptr<const std::atomic<bool>> state_;
+};
+
+
+class StopSource {
+public:
+    StopSource()
+        : state_(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    StopToken get_token() const {
+        return StopToken{state_};
+    }
+
+    void request_stop() {
+        state_->store(true, std::memory_order_relaxed);
+    }
+
+    bool stop_requested() const {
+        return state_->load(std::memory_order_relaxed);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state_;
+};
+
+
+// Wall-clock limit for a run (nullopt = none).
+using Deadline = std::optional<std::chrono::steady_clock::time_point>;
@@ -0,0 +1,1121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "aeroswarm/types.hpp"
+#include "aeroswarm/packed_cell.hpp"
+#include "aeroswarm/bitboard.hpp"
+#include "aeroswarm/neighborhood.hpp"
+#include "aeroswarm/terrain_locks.hpp"
+#include "aeroswarm/terrain_storage.hpp"
+
+/*
+Fixed-capacity container for neighboring terrain positions.
+
+Why not std::vector<Position>?
+
+A drone can have at most Capacity neighbors, the neighborhood policy's
+max_neighbors (see neighborhood.hpp): 4 on the sequential Terrain's
+4-connected grid, 6 on a hex grid, 8 on the parallel terrain's
+8-connected grid:
+
+    NW   N   NE
+      \  |  /
+    W -- D -- E
+      /  |  \
+    SW   S   SE
+
+So the capacity is known at compile time.
+
+The previous implementation used std::vector<Position>, which may
+dynamically allocate and grow its storage while available_neighbors()
+is running. Since neighbor discovery is part of the simulation hot path,
+we instead use std::array<Position, Capacity>.
+
+std::array:
+    - has fixed capacity
+    - stores its elements directly inside the object
+    - does not dynamically allocate storage for its elements
+    - provides contiguous storage
+    - supports STL-style iterators
+
+However, std::array<Position, Capacity> always contains Capacity
+Position objects, while a drone may currently have fewer valid
+neighbors.
+
+Therefore:
+
+    positions.size() == Capacity    // physical capacity
+    count                           // logical number of valid neighbors
+
+Example (Capacity = 8):
+
+    positions:
+    +-----+-----+-----+-----+-----+-----+-----+-----+
+    | P0  | P1  | P2  |  -  |  -  |  -  |  -  |  -  |
+    +-----+-----+-----+-----+-----+-----+-----+-----+
+
+    count = 3
+
+Only P0, P1 and P2 are logically part of this Neighbors collection.
+
+The helper functions below intentionally give Neighbors a small
+STL-container-like interface so existing simulation code can use:
+
+    neighbors.empty()
+    neighbors.size()
+    neighbors[i]
+
+and:
+
+    for (const auto& neighbor : neighbors)
+
+without knowing that the underlying storage is std::array.
+*/
+template <std::size_t Capacity>
+struct BasicNeighbors {
+    // Fixed storage for the maximum possible number of neighbors.
+    // No vector growth or dynamic element-storage allocation is required.
+    std::array<Position, Capacity> positions{};
+
+    // Number of positions currently containing valid neighbors.
+    // This is the logical size of the container, not its capacity.
+    std::size_t count{0};
+
+
+    /*
+    Allows:
+
+        if (neighbors.empty()) {
+            ...
+        }
+
+    We cannot use positions.empty() for this purpose because
+    std::array<Position, Capacity> is never empty (unless Capacity is
+    0): its size is always Capacity.
+
+    Instead, our logical container is empty when count == 0.
+    */
+    bool empty() const {
+        return count == 0;
+    }
+
+
+    /*
+    Allows:
+
+        neighbors.size()
+
+    positions.size() always returns Capacity because that is the physical
+    capacity of the std::array.
+
+    Our size() returns the number of VALID neighbors.
+    */
+    std::size_t size() const {
+        return count;
+    }
+
+
+    /*
+    Non-const begin().
+
+    Allows iteration over a mutable Neighbors object.
+
+    Example:
+
+        for (auto& neighbor : neighbors) {
+            ...
+        }
+
+    positions.begin() points to the first element of the array.
+    */
+    auto begin() {
+        return positions.begin();
+    }
+
+
+    /*
+    Non-const end().
+
+    IMPORTANT:
+    positions.end() would point after all Capacity array elements.
+
+    But perhaps only the first 3 positions are valid.
+
+    Therefore our logical end is:
+
+        positions.begin() + count
+
+    Example with count == 3:
+
+        begin()
+          |
+          v
+        [P0][P1][P2][--][--][--][--][--]
+                    ^
+                    |
+                   end()
+
+    This is what makes range-based for loops visit only valid neighbors.
+    */
+    auto end() {
+        return positions.begin() + count;
+    }
+
+
+    /*
+    Const begin().
+
+    Used when the Neighbors object itself is const.
+
+    Example:
+
+        const auto neighbors =
+            terrain.available_neighbors(position);
+
+        for (const auto& neighbor : neighbors) {
+            ...
+        }
+
+    Because neighbors is const, C++ needs const-compatible
+    begin()/end() functions.
+    */
+    auto begin() const {
+        return positions.begin();
+    }
+
+
+    /*
+    Const version of end().
+
+    Again, the logical end is determined by count rather than the
+    physical end of the Capacity-element std::array.
+    */
+    auto end() const {
+        return positions.begin() + count;
+    }
+
+
+    /*
+    Const indexing operator.
+
+    Allows:
+
+        const Neighbors neighbors = ...;
+
+        const Position& p = neighbors[2];
+
+    Returning const Position&:
+        - avoids copying Position
+        - prevents modification through a const Neighbors object
+    */
+    const Position& operator[](std::size_t index) const {
+        return positions[index];
+    }
+
+
+    /*
+    Non-const indexing operator.
+
+    Allows:
+
+        Neighbors neighbors;
+        neighbors[0] = Position{1, 2};
+
+    Returning Position& gives direct mutable access to the stored
+    Position object.
+    */
+    Position& operator[](std::size_t index) {
+        return positions[index];
+    }
+};
+
+// The 8-connected container used by ParallelTerrain.
+using Neighbors = BasicNeighbors<EightConnected::max_neighbors>;
+
+
+
+
+
+
+/*
+One available neighbor together with what the worker scores it by.
+*/
+struct ScoredNeighbor {
+    Position position{};
+    bool is_target{false};
+    int information_gain{0};
+};
+
+
+/*
+Fixed-capacity result of ParallelTerrain::scored_neighbors().
+
+Same idea as Neighbors above: at most Capacity entries, stored inline,
+with `count` as the logical size.
+*/
+template <std::size_t Capacity>
+struct BasicScoredNeighbors {
+    std::array<ScoredNeighbor, Capacity> entries{};
+    std::size_t count{0};
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    auto begin() const {
+        return entries.begin();
+    }
+
+    auto end() const {
+        return entries.begin() + count;
+    }
+
+    const ScoredNeighbor& operator[](std::size_t index) const {
+        return entries[index];
+    }
+};
+
+using ScoredNeighbors = BasicScoredNeighbors<EightConnected::max_neighbors>;
+
+/*
+One terrain implementation, three choices made at compile time:
+
+    LockPolicy     what a query / claim holds (terrain_locks.hpp)
+    Storage        how cells are stored (terrain_storage.hpp)
+    Neighborhood   which cells are neighbors (neighborhood.hpp)
+
+    Terrain           = BasicTerrain<NoLock, LayerStorage, FourConnected>
+    ParallelTerrain   = BasicTerrain<SelectableLock, AtomicStorage,
+                                     EightConnected>
+
+so the sequential and the parallel simulation run the same bounds,
+neighbor, gain and obstacle-scan code, and locking strategies can be
+benchmarked against each other on identical code (see
+bench_claim_contention).
+
+Every public operation first takes lock_.region(pos) (one cell's 3x3
+block) or lock_.all() (setup). With NoLock and AtomicCellsLock both are
+empty guards and compile to nothing.
+*/
+template <typename LockPolicy,
+          typename Storage,
+          typename Neighborhood = EightConnected>
+class BasicTerrain {
+    static_assert(!LockPolicy::concurrent || Storage::thread_safe,
+                  "a concurrent lock policy needs thread-safe storage");
+
+public:
+    using NeighborList = BasicNeighbors<Neighborhood::max_neighbors>;
+    using ScoredNeighborList = BasicScoredNeighbors<Neighborhood::max_neighbors>;
+    using LockOptions = typename LockPolicy::Options;
+
+    BasicTerrain(int w, int h, LockOptions options = LockOptions{})
+        : width_(w),
+          height_(h),
+          storage_(w, h),
+          lock_(w, h, options)
+    {
+        // Every cell starts free and unvisited, so its gain is the
+        // number of in-bounds neighbors (8-connected: 3 in a corner,
+        // 8 inside).
+        if constexpr (!Storage::lazy_gain) {
+            rebuild_gain();
+        }
+    }
+
+    // A fresh, unvisited terrain on an existing (shared) static layer
+    // (LayerStorage only).
+    explicit BasicTerrain(std::shared_ptr<const StaticTerrainLayer> layer,
+                          LockOptions options = LockOptions{})
+        : width_(layer->width()),
+          height_(layer->height()),
+          storage_(std::move(layer)),
+          lock_(width_, height_, options)
+    {
+    }
+
+    // Shared with every copy of this terrain until one of them changes
+    // an obstacle or the target (LayerStorage only).
+    std::shared_ptr<const StaticTerrainLayer> static_layer() const {
+        return storage_.static_layer();
+    }
+
+    // SelectableLock only.
+    TerrainSynchronization synchronization() const {
+        return lock_.synchronization();
+    }
+
+    bool in_bounds(const Position& pos) const {
+        return pos.x >= 0 &&
+               pos.x < width_ &&
+               pos.y >= 0 &&
+               pos.y < height_;
+    }
+
+    // Cells are stored packed, so this returns a decoded copy.
+    Cell cell_at(const Position& pos) const {
+        const auto lock = lock_.region(pos);
+
+        validate_position(pos);
+        return unpack_cell(load_cell(pos));
+    }
+
+    bool is_target(const Position& pos) const {
+        const auto lock = lock_.region(pos);
+
+        validate_position(pos);
+        return storage_.type_at(index(pos)) == CellType::Target;
+    }
+
+
+    /*
+    Marks pos visited whatever its type (the sequential walk only ever
+    moves to available cells). Visiting a cell twice changes nothing.
+    */
+    void mark_visited(const Position& pos) {
+        const auto lock = lock_.region(pos);
+
+        validate_position(pos);
+        visit(pos, storage_.type_at(index(pos)) != CellType::Obstacle);
+    }
+
+
+    bool try_claim_cell(const Position& pos) {
+        const auto lock = lock_.region(pos);
+
+        if (!in_bounds(pos)) {
+            return false;
+        }
+
+        if (storage_.type_at(index(pos)) == CellType::Obstacle) {
+            return false;
+        }
+
+        // AtomicStorage: one fetch_or, only the thread that moves the
+        // bit from 0 to 1 wins, every other caller sees it already set.
+        // Only the single winner then takes the cell out of its
+        // neighbors' gain and adds it to the visited journal, exactly
+        // once.
+        return visit(pos, true);
+    }
+
+
+    bool initialize_start_position(const Position& pos) {
+        const auto lock = lock_.region(pos);
+
+        if (!in_bounds(pos)) {
+            return false;
+        }
+
+        if (storage_.type_at(index(pos)) == CellType::Obstacle) {
+            return false;
+        }
+
+        // Several drones may share a start cell, so an already visited
+        // cell is fine: setting the bit again changes nothing.
+        visit(pos, true);
+        return true;
+    }
+
+
+    /*
+    Bitboard path: the 3x3 window of the obstacle and visited planes
+    gives the available neighbors as 9 bits, and the lookup table of the
+    row turns those bits into positions in direction-table order.
+
+        obstacle | visited      open                 Neighbors
+        1 0 0                   0 1 1
+        0 . 1          ──►      1 . 0      ──►       lookup[0b011'010'110]
+        0 0 0                   1 1 1
+
+    No bounds check (sentinel border), no branch per direction, no heap
+    allocation.
+    */
+    NeighborList available_neighbors(const Position& pos) const {
+        const auto lock = lock_.region(pos);
+
+        validate_position(pos);
+
+        const auto& directions = row_directions<Neighborhood>(pos.y);
+        const NeighborLookupEntry& entry =
+            row_lookup(pos.y)[open_window(pos)];
+
+        NeighborList candidates;
+        candidates.count = entry.count;
+
+        // Every slot: a fixed trip count unrolls, the ones past `count`
+        // are not part of the result.
+        for (std::size_t k = 0; k < candidates.positions.size(); ++k) {
+            candidates.positions[k] = pos + directions[entry.directions[k]];
+        }
+
+        return candidates;
+    }
+
+
+    /*
+    Neighbors of pos that are not obstacles, visited or not: the cells a
+    drone can fly through when it routes back to unexplored ground (see
+    frontier.hpp). Same lookup as available_neighbors(), on the obstacle
+    plane alone.
+    */
+    NeighborList passable_neighbors(const Position& pos) const {
+        const auto lock = lock_.region(pos);
+
+        validate_position(pos);
+
+        const auto& directions = row_directions<Neighborhood>(pos.y);
+        const NeighborLookupEntry& entry =
+            row_lookup(pos.y)[~storage_.obstacle_window(pos) & 0x1FFu];
+
+        NeighborList candidates;
+        candidates.count = entry.count;
+
+        for (std::size_t k = 0; k < candidates.positions.size(); ++k) {
+            candidates.positions[k] = pos + directions[entry.directions[k]];
+        }
+
+        return candidates;
+    }
+
+
+    /*
+    BEFORE
+
+    std::vector<Position>
+            │
+            ├── dynamic capacity
+            ├── allocator involvement
+            └── 1031 growth events / 274 calls
+
+
+    AFTER
+
+    Neighbors
+    ┌──────────────────────┐
+    │ std::array<Pos, 8>   │
+    │ count                │
+    └──────────────────────┘
+            │
+            ├── fixed capacity
+            ├── storage embedded in object
+            └── 0 vector growth events
+
+    */
+    std::vector<Position> available_neighbors_vector(const Position& pos) const {
+        const auto lock = lock_.region(pos);
+
+        validate_position(pos);
+
+        neighbor_calls_.value.fetch_add(1);
+
+        std::vector<Position> candidates;
+
+        std::size_t previous_capacity = candidates.capacity();
+
+        for (const auto& dir : row_directions<Neighborhood>(pos.y)) {
+            const Position next = pos + dir;
+
+            if (!in_bounds(next)) {
+                continue;
+            }
+
+            if (!cell_available(load_cell(next))) {
+                continue;
+            }
+
+            candidates.push_back(next);
+
+            if (candidates.capacity() !=previous_capacity) {
+                neighbor_capacity_growths_.value.fetch_add(1);
+                previous_capacity = candidates.capacity();
+            }
+        }
+
+        return candidates;
+    }
+
+    std::size_t neighbor_calls() const {
+        return neighbor_calls_.value.load();
+    }
+
+    std::size_t neighbor_capacity_growths() const {
+        return neighbor_capacity_growths_.value.load();
+    }
+
+
+    /*
+    Everything one drone move needs, under ONE lock acquisition.
+
+    The worker used to do:
+
+        available_neighbors(pos)          1 lock
+        is_target(candidate)     x <= 8   8 locks
+        information_gain(cand.)  x <= 8   8 locks
+                                         ─────────
+                                         ~17 locks per move (+ claim)
+
+    scored_neighbors() walks the neighborhood once and returns, for
+    every available neighbor, its target flag and information gain.
+    The claim is still a separate try_claim_cell() call, and remains
+    the authoritative check.
+    */
+    ScoredNeighborList scored_neighbors(const Position& pos) const {
+        const auto lock = lock_.region(pos);
+
+        validate_position(pos);
+        ensure_gain();
+
+        const auto& directions = row_directions<Neighborhood>(pos.y);
+        const NeighborLookupEntry& entry =
+            row_lookup(pos.y)[open_window(pos)];
+
+        ScoredNeighborList candidates;
+        candidates.count = entry.count;
+
+        for (std::size_t k = 0; k < entry.count; ++k) {
+            const Position next = pos + directions[entry.directions[k]];
+
+            ScoredNeighbor& candidate = candidates.entries[k];
+
+            candidate.position = next;
+            candidate.is_target =
+                storage_.type_at(index(next)) == CellType::Target;
+            candidate.information_gain = storage_.gain(index(next));
+        }
+
+        return candidates;
+    }
+
+
+    /*
+    Number of available (unvisited, non-obstacle) neighbors of pos.
+
+    This is not a scan: the terrain keeps the count per cell and updates
+    it whenever a cell stops (or starts) being available:
+
+        claim (2,2)
+                                       gain of every neighbor of (2,2)
+            . . . . .                  goes down by one:
+            . n n n .
+            . n X n .                  n: gain -= 1
+            . n n n .
+            . . . . .
+
+    So a lookup is a single load instead of a neighbor scan. With
+    LayerStorage the field is only built (one pass) on the first call;
+    until then a random-walk terrain stays at one bit per cell.
+
+    Throws std::out_of_range for a position outside the map, on every
+    terrain (ParallelTerrain used to return 0 there).
+    */
+    int information_gain(const Position& pos) const {
+        const auto lock = lock_.region(pos);
+
+        validate_position(pos);
+        ensure_gain();
+
+        return storage_.gain(index(pos));
+    }
+
+
+    void set_obstacle(const Position& pos) {
+        const auto lock = lock_.all();
+
+        validate_position(pos);
+        store_type(pos, CellType::Obstacle);
+
+        std::lock_guard<StaticMutex> static_lock(static_mtx_);
+
+        if (storage_.target() == pos) {
+            storage_.set_target(std::nullopt);
+        }
+
+        obstacles_.reset();
+    }
+
+
+    // A terrain has one target: moving it turns the previous target
+    // cell back into a free cell.
+    void set_target(const Position& pos) {
+        const auto lock = lock_.all();
+
+        validate_position(pos);
+
+        const bool was_obstacle =
+            storage_.type_at(index(pos)) == CellType::Obstacle;
+
+        std::lock_guard<StaticMutex> static_lock(static_mtx_);
+
+        const std::optional<Position> previous = storage_.target();
+
+        if (previous.has_value() && !(previous.value() == pos)) {
+            store_type(previous.value(), CellType::Free);
+        }
+
+        store_type(pos, CellType::Target);
+        storage_.set_target(pos);
+
+        if (was_obstacle) {
+            obstacles_.reset();
+        }
+    }
+
+
+    /*
+    Replaces the whole obstacle layer in one pass:
+
+        previous obstacles   -> free
+        `obstacles`          -> obstacle (duplicates are fine)
+
+    Visited bits are kept. The obstacle list handed to snapshots is
+    `obstacles` itself (in the given order, without duplicates) instead
+    of a width x height scan. Every position is validated before
+    anything is written.
+
+    Together with reset_visited() this lets one terrain serve many
+    scenarios of the same size without reallocating:
+
+        terrain.reset_visited();
+        terrain.set_target(scenario.target);
+        terrain.set_obstacles(scenario.obstacles);
+
+    Setup only: no drone may be running on this terrain.
+    */
+    void set_obstacles(const std::vector<Position>& obstacles) {
+        for (const auto& pos : obstacles) {
+            validate_position(pos);
+        }
+
+        auto positions = std::make_shared<std::vector<Position>>();
+        positions->reserve(obstacles.size());
+
+        const auto lock = lock_.all();
+        std::lock_guard<StaticMutex> static_lock(static_mtx_);
+
+        // Copy: the cached list is replaced below.
+        const SharedPositions previous = obstacle_positions_unlocked();
+
+        for (const auto& pos : *previous) {
+            store_type_exclusive(pos, CellType::Free);
+        }
+
+        for (const auto& pos : obstacles) {
+            // Already an obstacle: a duplicate within `obstacles`.
+            if (storage_.type_at(index(pos)) == CellType::Obstacle) {
+                continue;
+            }
+
+            store_type_exclusive(pos, CellType::Obstacle);
+            positions->push_back(pos);
+
+            if (storage_.target() == pos) {
+                storage_.set_target(std::nullopt);
+            }
+        }
+
+        obstacles_ = std::move(positions);
+    }
+
+
+    /*
+    Clears the visited layer: every cell becomes unvisited and the
+    visited journal becomes empty (epoch 0 again). Obstacles and the
+    target are kept.
+
+    The journal already lists exactly the visited cells, so only those
+    are touched: O(visited cells), not a scan of the grid. Their
+    neighbors get their information gain back, so the gain field ends
+    up as on a fresh terrain.
+
+    Setup only: no drone may be running on this terrain. With a single
+    writer, the cells and the gain field are updated with plain relaxed
+    loads and stores instead of fetch_or / fetch_add, which is what
+    makes a reset cheaper than building a new terrain.
+    */
+    void reset_visited() {
+        const auto lock = lock_.all();
+
+        storage_.drain_visited_exclusive([this](const Position& pos) {
+            storage_.unclaim_exclusive(pos);
+
+            if (storage_.type_at(index(pos)) != CellType::Obstacle) {
+                adjust_neighbor_gain_exclusive(pos, 1);
+            }
+        });
+    }
+
+
+    // Full list, in the order the cells were visited.
+    std::vector<Position> visited_positions() const {
+        std::vector<Position> positions;
+        visited_since(0, positions);
+        return positions;
+    }
+
+
+    /*
+    Visited journal.
+
+    Every cell enters it once, when it is first visited. An "epoch" is
+    simply a position in this log. A consumer remembers the epoch
+    returned by its last call and only receives the cells visited after
+    it:
+
+        epoch = terrain.visited_since(0, cells);       // everything
+        ...
+        epoch = terrain.visited_since(epoch, delta);   // only new cells
+
+    Appends `out` with the cells in [epoch, returned epoch). `limit`
+    caps the returned epoch, e.g. to stop at a published frame. Reading
+    takes no lock (AtomicStorage: see its append_visited()).
+    */
+    std::size_t visited_since(std::size_t epoch,
+                              std::vector<Position>& out,
+                              std::size_t limit =
+                                  std::numeric_limits<std::size_t>::max()) const
+    {
+        return storage_.visited_since(epoch, out, limit);
+    }
+
+    std::size_t visited_count() const {
+        return storage_.visited_count();
+    }
+
+
+    std::vector<Position> obstacle_positions() const {
+        return *shared_obstacle_positions();
+    }
+
+
+    /*
+    Static layers: obstacles and target.
+
+    They are fixed once the scenario is loaded, so snapshot() should not
+    rescan width x height cells 60 times a second.
+
+        target_position()              recorded by set_target()
+        shared_obstacle_positions()    one scan on first use (or the list
+                                       given to set_obstacles()), then the
+                                       same immutable buffer is handed to
+                                       every snapshot:
+
+        snapshot 1 ──┐
+        snapshot 2 ──┼──► same const std::vector<Position>
+        snapshot 3 ──┘
+
+    Both are guarded by static_mtx_, which drone workers never take, so
+    a snapshot reading the static layers does not block any worker.
+    set_obstacle() drops the cached list; the next call rebuilds it.
+    */
+    SharedPositions shared_obstacle_positions() const {
+        std::lock_guard<StaticMutex> static_lock(static_mtx_);
+
+        return obstacle_positions_unlocked();
+    }
+
+    std::optional<Position> target_position() const {
+        std::lock_guard<StaticMutex> static_lock(static_mtx_);
+
+        return storage_.target();
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    // Row-major: cell (x, y) is y * width() + x.
+    std::size_t cell_count() const {
+        return static_cast<std::size_t>(width_) *
+               static_cast<std::size_t>(height_);
+    }
+
+    // Heap bytes of the cell-type grid, see the storage.
+    std::size_t storage_bytes() const {
+        return storage_.storage_bytes();
+    }
+
+    std::size_t owned_storage_bytes() const {
+        return storage_.owned_storage_bytes();
+    }
+
+private:
+    using StaticMutex = typename LockPolicy::StaticMutex;
+
+    // available_neighbors_vector() instrumentation. Copyable, so a
+    // single-threaded terrain stays copyable.
+    struct CallCounter {
+        std::atomic<std::size_t> value{0};
+
+        CallCounter() = default;
+
+        CallCounter(const CallCounter& other)
+            : value(other.value.load())
+        {
+        }
+
+        CallCounter& operator=(const CallCounter& other) {
+            value.store(other.value.load());
+            return *this;
+        }
+    };
+
+    int width_;
+    int height_;
+
+    Storage storage_;
+    LockPolicy lock_;
+
+    // Static layers, see shared_obstacle_positions(). The target lives
+    // in the storage.
+    mutable StaticMutex static_mtx_;
+    mutable SharedPositions obstacles_;
+
+    mutable CallCounter neighbor_calls_;
+    mutable CallCounter neighbor_capacity_growths_;
+
+    // Built at compile time from the direction tables, see bitboard.hpp.
+    static constexpr NeighborLookup neighbor_lookup_ =
+        make_neighbor_lookup(Neighborhood::directions);
+
+    static constexpr NeighborLookup odd_row_lookup_ =
+        make_neighbor_lookup(Neighborhood::odd_row_directions);
+
+
+    std::size_t index(const Position& pos) const {
+        return static_cast<std::size_t>(pos.y) *
+               static_cast<std::size_t>(width_) +
+               static_cast<std::size_t>(pos.x);
+    }
+
+    void validate_position(const Position& pos) const {
+        if (!in_bounds(pos)) {
+            throw std::out_of_range("Position is outside terrain bounds");
+        }
+    }
+
+    const NeighborLookup& row_lookup(int y) const {
+        if constexpr (Neighborhood::offset_rows) {
+            if (y & 1) {
+                return odd_row_lookup_;
+            }
+        }
+
+        (void)y;
+        return neighbor_lookup_;
+    }
+
+    // Available neighbors of pos as a 3x3 window (see Bitboard::window).
+    std::uint32_t open_window(const Position& pos) const {
+        return ~storage_.blocked_window(pos) & 0x1FFu;
+    }
+
+    // Type from the storage + visited bit.
+    PackedCell load_cell(const Position& pos) const {
+        return pack_cell(storage_.type_at(index(pos)), storage_.visited(pos));
+    }
+
+    /*
+    First visit of pos: journal entry, and, when pos was available,
+    its neighbors lose it from their gain. Returns false when pos was
+    already visited.
+    */
+    bool visit(const Position& pos, bool available) {
+        if (!storage_.claim(pos)) {
+            return false;
+        }
+
+        if (available) {
+            update_neighbor_gain(pos, true, false);
+        }
+
+        storage_.append_visited(pos, index(pos));
+        return true;
+    }
+
+    void ensure_gain() const {
+        if constexpr (Storage::lazy_gain) {
+            if (!storage_.has_gain()) {
+                rebuild_gain();
+            }
+        }
+    }
+
+    /*
+    Recomputes the gain field from the two bitplanes, a whole row per
+    kernel call (see count_open_neighbors()).
+    */
+    void rebuild_gain() const {
+        constexpr std::uint32_t even_row_mask =
+            neighbor_window_mask(Neighborhood::directions);
+        constexpr std::uint32_t odd_row_mask =
+            neighbor_window_mask(Neighborhood::odd_row_directions);
+
+        storage_.allocate_gain();
+
+        const std::size_t stride = storage_.stride();
+
+        // Padded rows y, y + 1, y + 2 (= cell rows y - 1, y, y + 1),
+        // each with one spare word on both sides for the kernel.
+        std::vector<std::uint64_t> rows(3 * (stride + 2), ~std::uint64_t{0});
+        std::vector<std::uint8_t> counts(stride * 64);
+
+        for (int y = 0; y < height_; ++y) {
+            for (int r = 0; r < 3; ++r) {
+                storage_.copy_blocked_row(
+                    y + r,
+                    rows.data() + static_cast<std::size_t>(r) * (stride + 2) + 1
+                );
+            }
+
+            count_open_neighbors(
+                default_neighbor_kernel(),
+                rows.data() + 1,
+                rows.data() + (stride + 2) + 1,
+                rows.data() + 2 * (stride + 2) + 1,
+                stride,
+                (y & 1) ? odd_row_mask : even_row_mask,
+                counts.data()
+            );
+
+            for (int x = 0; x < width_; ++x) {
+                storage_.store_gain(
+                    index({x, y}),
+                    counts[static_cast<std::size_t>(x) + 1]
+                );
+            }
+        }
+    }
+
+    /*
+    Keep the gain field in sync when pos changes availability.
+
+        available -> unavailable   neighbors' gain - 1
+        unavailable -> available   neighbors' gain + 1  (setup only,
+                                   e.g. an obstacle replaced by the target)
+    */
+    void update_neighbor_gain(const Position& pos,
+                              bool was_available,
+                              bool is_available)
+    {
+        if (was_available == is_available || !storage_.has_gain()) {
+            return;
+        }
+
+        for (const auto& dir : row_directions<Neighborhood>(pos.y)) {
+            const Position next = pos + dir;
+
+            if (!in_bounds(next)) {
+                continue;
+            }
+
+            storage_.add_gain(index(next), is_available ? 1 : -1);
+        }
+    }
+
+    /*
+    Setup-only variant (reset_visited(), set_obstacles()): the caller is
+    the only writer, so a read-modify-write does not need to be one
+    atomic instruction.
+    */
+    void adjust_neighbor_gain_exclusive(const Position& pos, int delta) {
+        if (!storage_.has_gain()) {
+            return;
+        }
+
+        const auto& directions = row_directions<Neighborhood>(pos.y);
+
+        // Interior cell: every neighbor exists, no bounds checks. The
+        // table is constexpr, so this unrolls into direct index adjusts.
+        if (pos.x > 0 && pos.x < width_ - 1 &&
+            pos.y > 0 && pos.y < height_ - 1) {
+            const std::ptrdiff_t center =
+                static_cast<std::ptrdiff_t>(index(pos));
+
+            for (const auto& dir : directions) {
+                storage_.add_gain_exclusive(
+                    static_cast<std::size_t>(
+                        center + static_cast<std::ptrdiff_t>(dir.y) * width_ +
+                        dir.x
+                    ),
+                    delta
+                );
+            }
+
+            return;
+        }
+
+        for (const auto& dir : directions) {
+            const Position next = pos + dir;
+
+            if (in_bounds(next)) {
+                storage_.add_gain_exclusive(index(next), delta);
+            }
+        }
+    }
+
+    // Change the CellType, keep the visited bit.
+    void store_type(const Position& pos, CellType type) {
+        const PackedCell current = load_cell(pos);
+
+        storage_.store_type(pos, index(pos), type);
+
+        update_neighbor_gain(
+            pos,
+            cell_available(current),
+            cell_available(with_cell_type(current, type))
+        );
+    }
+
+    void store_type_exclusive(const Position& pos, CellType type) {
+        const PackedCell current = load_cell(pos);
+        const PackedCell updated = with_cell_type(current, type);
+
+        storage_.store_type_exclusive(pos, index(pos), type);
+
+        if (cell_available(current) != cell_available(updated)) {
+            adjust_neighbor_gain_exclusive(
+                pos,
+                cell_available(updated) ? 1 : -1
+            );
+        }
+    }
+
+    // Caller holds static_mtx_.
+    const SharedPositions& obstacle_positions_unlocked() const {
+        if (!obstacles_) {
+            auto positions = std::make_shared<std::vector<Position>>();
+
+            for (int y = 0; y < height_; ++y) {
+                for (int x = 0; x < width_; ++x) {
+                    if (storage_.type_at(index({x, y})) == CellType::Obstacle) {
+                        positions->push_back({x, y});
+                    }
+                }
+            }
+
+            obstacles_ = std::move(positions);
+        }
+
+        return obstacles_;
+    }
+};
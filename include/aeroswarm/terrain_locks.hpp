@@ -0,0 +1,488 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "aeroswarm/types.hpp"
+
+/*
+Lock policies for BasicTerrain (see terrain.hpp).
+
+Every terrain operation touches at most the 3x3 block around one cell:
+a claim clears the cell from its neighbors' information gain, a query
+reads the neighbors. A policy decides what has to be held for that:
+
+    region(pos)   before reading / writing the 3x3 block around pos
+    all()         before a setup operation (obstacles, target, reset)
+
+Both return a guard that releases on destruction.
+
+    policy           region(pos)                   needs atomic storage
+    ───────────────  ────────────────────────────  ────────────────────
+    NoLock           nothing (one thread only)     no
+    GlobalMutexLock  the one mutex                 yes (lock-free journal
+                                                   readers)
+    StripedLock      the row stripes of y-1..y+1   yes
+    TiledLock        the 1, 2 or 4 tiles of the    yes
+                     3x3 block
+    AtomicCellsLock  nothing: claims are atomic    yes
+    SelectableLock   GlobalMutex, Tiled or         yes
+                     nothing, chosen at run time
+
+`concurrent` says whether several threads may use the terrain at once;
+BasicTerrain refuses a concurrent policy on storage that is not
+thread-safe.
+
+StaticMutex guards the static layers (target, obstacle list cache).
+NoLock uses NullMutex so a single-threaded terrain stays copyable and
+never touches a real mutex.
+*/
+
+
+// Satisfies BasicLockable, does nothing.
+struct NullMutex {
+    void lock() {}
+    void unlock() {}
+};
+
+
+// The user-provided destructor makes `const auto lock = ...` a guard
+// object to the compiler too (no unused-variable warning).
+struct NullGuard {
+    ~NullGuard() {}
+};
+
+
+struct NoLock {
+    static constexpr bool concurrent = false;
+
+    struct Options {
+    };
+
+    using StaticMutex = NullMutex;
+
+    NoLock(int /*width*/, int /*height*/, Options /*options*/) {
+    }
+
+    NullGuard region(const Position& /*pos*/) const {
+        return {};
+    }
+
+    NullGuard all() const {
+        return {};
+    }
+};
+
+
+struct GlobalMutexLock {
+    static constexpr bool concurrent = true;
+
+    struct Options {
+    };
+
+    using StaticMutex = std::mutex;
+
+    GlobalMutexLock(int /*width*/, int /*height*/, Options /*options*/) {
+    }
+
+    std::unique_lock<std::mutex> region(const Position& /*pos*/) const {
+        return std::unique_lock<std::mutex>(mtx_);
+    }
+
+    std::unique_lock<std::mutex> all() const {
+        return std::unique_lock<std::mutex>(mtx_);
+    }
+
+private:
+    mutable std::mutex mtx_;
+};
+
+
+/*
+One mutex per band of `rows_per_stripe` rows:
+
+    rows  0.. 3   stripe 0
+    rows  4.. 7   stripe 1        region((x, 7)) needs rows 6..8
+    rows  8..11   stripe 2        = stripes 1 and 2
+    ...
+
+The stripes of a region are always a contiguous range, and they are
+taken in increasing order (all() takes every stripe, also in order), so
+two threads can never wait on each other in a cycle. Drones on
+different bands never contend.
+*/
+class StripedLock {
+public:
+    static constexpr bool concurrent = true;
+
+    struct Options {
+        int rows_per_stripe{4};
+    };
+
+    using StaticMutex = std::mutex;
+
+    // Holds stripes [first, last]; unlocks them in reverse order.
+    class Guard {
+    public:
+        Guard(const StripedLock& owner, std::size_t first, std::size_t last)
+            : owner_(&owner),
+              first_(first),
+              last_(last)
+        {
+            for (std::size_t s = first_; s <= last_; ++s) {
+                owner_->stripes_[s].mtx.lock();
+            }
+        }
+
+        Guard(Guard&& other) noexcept
+            : owner_(other.owner_),
+              first_(other.first_),
+              last_(other.last_)
+        {
+            other.owner_ = nullptr;
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+        ~Guard() {
+            if (owner_ == nullptr) {
+                return;
+            }
+
+            for (std::size_t s = last_ + 1; s-- > first_;) {
+                owner_->stripes_[s].mtx.unlock();
+            }
+        }
+
+    private:
+        const StripedLock* owner_;
+        std::size_t first_;
+        std::size_t last_;
+    };
+
+    StripedLock(int /*width*/, int height, Options options)
+        : height_(height),
+          rows_per_stripe_(std::max(1, options.rows_per_stripe)),
+          stripe_count_(static_cast<std::size_t>(
+              (std::max(1, height) + rows_per_stripe_ - 1) / rows_per_stripe_
+          )),
+          stripes_(std::make_unique<Stripe[]>(stripe_count_))
+    {
+    }
+
+    Guard region(const Position& pos) const {
+        // Clamped, so an out-of-bounds pos (rejected by the caller
+        // afterwards) still names real stripes.
+        const int top = std::clamp(pos.y - 1, 0, std::max(0, height_ - 1));
+        const int bottom = std::clamp(pos.y + 1, 0, std::max(0, height_ - 1));
+
+        return Guard(*this, stripe_of(top), stripe_of(bottom));
+    }
+
+    Guard all() const {
+        return Guard(*this, 0, stripe_count_ - 1);
+    }
+
+    std::size_t stripe_count() const {
+        return stripe_count_;
+    }
+
+private:
+    // One cache line each, so neighbouring stripes do not false-share.
+    struct alignas(64) Stripe {
+        std::mutex mtx;
+    };
+
+    std::size_t stripe_of(int y) const {
+        return static_cast<std::size_t>(y / rows_per_stripe_);
+    }
+
+    int height_;
+    int rows_per_stripe_;
+    std::size_t stripe_count_;
+    std::unique_ptr<Stripe[]> stripes_;
+};
+
+
+/*
+One mutex per square tile of `tile_size` x `tile_size` cells:
+
+    tile_size 32               region((31, 40)) needs x 30..32, y 39..41
+    ┌────┬────┬────┐
+    │  0 │  1 │  2 │           = tiles 3 and 4
+    ├────┼────┼────┤
+    │  3 │  4 │  5 │           region((31, 31)): tiles 0, 1, 3 and 4
+    ├────┼────┼────┤
+    │  6 │  7 │  8 │
+    └────┴────┴────┘
+
+Inside a tile a region is one tile, on an edge two, at a corner four.
+The tiles of a region are always a rectangle and are taken in
+increasing tile index (row by row, left to right); all() takes every
+tile in the same order. Every thread therefore acquires tiles in one
+global order and no cycle of waiting threads can form. Drones in
+different tiles never touch the same mutex.
+*/
+class TiledLock {
+public:
+    static constexpr bool concurrent = true;
+
+    struct Options {
+        int tile_size{32};
+    };
+
+    using StaticMutex = std::mutex;
+
+    // Holds the tiles [first_x, last_x] x [first_y, last_y]; unlocks
+    // them in reverse order. A default-constructed guard holds nothing.
+    class Guard {
+    public:
+        Guard()
+            : owner_(nullptr)
+        {
+        }
+
+        Guard(const TiledLock& owner,
+              std::size_t first_x,
+              std::size_t last_x,
+              std::size_t first_y,
+              std::size_t last_y)
+            : owner_(&owner),
+              first_x_(first_x),
+              last_x_(last_x),
+              first_y_(first_y),
+              last_y_(last_y)
+        {
+            for (std::size_t ty = first_y_; ty <= last_y_; ++ty) {
+                for (std::size_t tx = first_x_; tx <= last_x_; ++tx) {
+                    owner_->tile(tx, ty).lock();
+                }
+            }
+        }
+
+        Guard(Guard&& other) noexcept
+            : owner_(other.owner_),
+              first_x_(other.first_x_),
+              last_x_(other.last_x_),
+              first_y_(other.first_y_),
+              last_y_(other.last_y_)
+        {
+            other.owner_ = nullptr;
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+        ~Guard() {
+            if (owner_ == nullptr) {
+                return;
+            }
+
+            for (std::size_t ty = last_y_ + 1; ty-- > first_y_;) {
+                for (std::size_t tx = last_x_ + 1; tx-- > first_x_;) {
+                    owner_->tile(tx, ty).unlock();
+                }
+            }
+        }
+
+    private:
+        const TiledLock* owner_;
+        std::size_t first_x_{0};
+        std::size_t last_x_{0};
+        std::size_t first_y_{0};
+        std::size_t last_y_{0};
+    };
+
+    TiledLock(int width, int height, Options options)
+        : width_(std::max(1, width)),
+          height_(std::max(1, height)),
+          tile_size_(std::max(1, options.tile_size)),
+          tiles_x_(static_cast<std::size_t>(
+              (width_ + tile_size_ - 1) / tile_size_
+          )),
+          tiles_y_(static_cast<std::size_t>(
+              (height_ + tile_size_ - 1) / tile_size_
+          )),
+          tiles_(std::make_unique<Tile[]>(tiles_x_ * tiles_y_))
+    {
+    }
+
+    Guard region(const Position& pos) const {
+        // Clamped, so an out-of-bounds pos (rejected by the caller
+        // afterwards) still names real tiles.
+        const int left = std::clamp(pos.x - 1, 0, width_ - 1);
+        const int right = std::clamp(pos.x + 1, 0, width_ - 1);
+        const int top = std::clamp(pos.y - 1, 0, height_ - 1);
+        const int bottom = std::clamp(pos.y + 1, 0, height_ - 1);
+
+        return Guard(
+            *this,
+            tile_of(left), tile_of(right),
+            tile_of(top), tile_of(bottom)
+        );
+    }
+
+    Guard all() const {
+        return Guard(*this, 0, tiles_x_ - 1, 0, tiles_y_ - 1);
+    }
+
+    std::size_t tile_count() const {
+        return tiles_x_ * tiles_y_;
+    }
+
+private:
+    // One cache line each, so neighbouring tiles do not false-share.
+    struct alignas(64) Tile {
+        std::mutex mtx;
+    };
+
+    std::size_t tile_of(int coordinate) const {
+        return static_cast<std::size_t>(coordinate / tile_size_);
+    }
+
+    std::mutex& tile(std::size_t tx, std::size_t ty) const {
+        return tiles_[ty * tiles_x_ + tx].mtx;
+    }
+
+    int width_;
+    int height_;
+    int tile_size_;
+    std::size_t tiles_x_;
+    std::size_t tiles_y_;
+    std::unique_ptr<Tile[]> tiles_;
+};
+
+
+/*
+No lock at all: every shared word is an atomic and a claim is a single
+fetch_or (see AtomicStorage), so correctness does not depend on locks.
+*/
+struct AtomicCellsLock {
+    static constexpr bool concurrent = true;
+
+    struct Options {
+    };
+
+    using StaticMutex = std::mutex;
+
+    AtomicCellsLock(int /*width*/, int /*height*/, Options /*options*/) {
+    }
+
+    NullGuard region(const Position& /*pos*/) const {
+        return {};
+    }
+
+    NullGuard all() const {
+        return {};
+    }
+};
+
+
+/*
+How concurrent access to the cells is synchronized.
+
+GlobalMutex
+    every query and claim takes one mutex (the original behaviour).
+
+LockFree
+    no mutex on the hot path. Visited state lives in an atomic bitplane
+    (see bitboard.hpp), cell types in std::atomic<PackedCell> bytes:
+
+        try_claim_cell()        one fetch_or on the cell's visited word
+        available_neighbors()   acquire loads of 3 + 3 bitplane words
+        is_target() / information_gain()  acquire loads
+
+    Exactly one thread can win a claim, because only one fetch_or can
+    see the cell's bit go from "not visited" to "visited":
+
+        Thread A: fetch_or(bit) ── old bit 0 ── success
+        Thread B: fetch_or(bit) ── old bit 1 ── returns false
+
+    Readers of the visited journal may miss a claim whose fetch_or has
+    succeeded but whose journal entry is not written yet; they pick it
+    up on their next read.
+
+Tiled
+    every query and claim locks the 32 x 32 tiles its 3x3 block touches
+    (see TiledLock): one tile away from tile edges, at most four.
+    Drones in different tiles never contend.
+
+All modes use the same atomic storage. Under GlobalMutex and Tiled the
+atomics are simply accessed while holding the lock(s).
+*/
+enum class TerrainSynchronization {
+    GlobalMutex,
+    LockFree,
+    Tiled
+};
+
+
+// GlobalMutexLock, TiledLock or AtomicCellsLock, picked when the
+// terrain is built.
+class SelectableLock {
+public:
+    static constexpr bool concurrent = true;
+
+    using Options = TerrainSynchronization;
+    using StaticMutex = std::mutex;
+
+    // Owns mtx_, the tiles of a region, or nothing (LockFree).
+    struct Guard {
+        std::unique_lock<std::mutex> global;
+        TiledLock::Guard tiles;
+    };
+
+    SelectableLock(int width, int height, Options synchronization)
+        : synchronization_(synchronization)
+    {
+        if (synchronization_ == TerrainSynchronization::Tiled) {
+            tiled_.emplace(width, height, TiledLock::Options{});
+        }
+    }
+
+    /*
+    GlobalMutex: returns a guard that owns mtx_.
+    Tiled:       returns a guard that owns the tiles around pos.
+    LockFree:    returns an empty guard, nothing is acquired.
+    */
+    Guard region(const Position& pos) const {
+        if (tiled_) {
+            return Guard{std::unique_lock<std::mutex>(), tiled_->region(pos)};
+        }
+
+        return Guard{lock_global(), TiledLock::Guard()};
+    }
+
+    Guard all() const {
+        if (tiled_) {
+            return Guard{std::unique_lock<std::mutex>(), tiled_->all()};
+        }
+
+        return Guard{lock_global(), TiledLock::Guard()};
+    }
+
+    TerrainSynchronization synchronization() const {
+        return synchronization_;
+    }
+
+private:
+    std::unique_lock<std::mutex> lock_global() const {
+        if (synchronization_ == TerrainSynchronization::GlobalMutex) {
+            return std::unique_lock<std::mutex>(mtx_);
+        }
+
+        return std::unique_lock<std::mutex>();
+    }
+
+    TerrainSynchronization synchronization_;
+    mutable std::mutex mtx_;
+
+    // Only built in Tiled mode.
+    std::optional<TiledLock> tiled_;
+};
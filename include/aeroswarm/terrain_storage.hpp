@@ -0,0 +1,599 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "aeroswarm/types.hpp"
+#include "aeroswarm/packed_cell.hpp"
+#include "aeroswarm/bitboard.hpp"
+
+/*
+Storage policies for BasicTerrain (see terrain.hpp).
+
+A storage holds the raw per-cell state and knows how to read and write
+it; BasicTerrain holds the logic on top (bounds, neighbors, information
+gain bookkeeping, the obstacle list), written once for both.
+
+                       LayerStorage                 AtomicStorage
+    cell types         shared StaticTerrainLayer    std::atomic bytes
+    obstacle plane     in the layer                 own Bitboard
+    visited plane      Bitboard, relaxed access     Bitboard, fetch_or
+    information gain   bytes, built on first use    atomic bytes, eager
+    visited journal    std::vector<Position>        fixed atomic slots
+    copyable           yes (shares the layer)       no
+    thread_safe        no                           yes
+
+Both keep obstacles and visited cells as bitplanes with a sentinel
+border, so neighbor queries are bitboard windows for either storage.
+*/
+
+
+/*
+The part of a terrain that does not change while drones fly: the cell
+types (free / obstacle / target) and the target position.
+
+    StaticTerrainLayer (one per map, shared, read-only)
+    ┌────────────────────────┐
+    │ cell types, 1 B / cell │◄──┬── Terrain of run 1: visited bitmap
+    │ obstacle bitplane      │   ├── Terrain of run 2: visited bitmap
+    │ target                 │   └── ...         (1 bit / cell each)
+    └────────────────────────┘
+
+A Terrain only owns the run state on top of it. Copying a Terrain, e.g.
+into a Simulation, shares the layer and copies the bitmap, so 32 runs
+of the same map hold one copy of the cell types instead of 32.
+
+The layer is never written while it is shared: set_obstacle() and
+set_target() on a Terrain whose layer is shared first give that Terrain
+its own copy (copy-on-write), and the other terrains keep the old one.
+Simulations on different threads can therefore share a layer without
+any synchronization.
+*/
+class StaticTerrainLayer {
+public:
+    StaticTerrainLayer(int w, int h)
+        : width_(w),
+          height_(h),
+          cells_(static_cast<std::size_t>(w) * static_cast<std::size_t>(h),
+                 pack_cell(CellType::Free, false)),
+          obstacle_plane_(w, h, true)
+    {
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    std::optional<Position> target_position() const {
+        return target_;
+    }
+
+private:
+    friend class LayerStorage;
+
+    int width_;
+    int height_;
+
+    // Row-major: cells_[y * width_ + x]. Type bits only, the visited
+    // bit is never set here. See packed_cell.hpp.
+    std::vector<PackedCell> cells_;
+
+    // Mirrors the Obstacle type, border = 1 (see bitboard.hpp).
+    Bitboard obstacle_plane_;
+
+    std::optional<Position> target_;
+};
+
+
+/*
+Single-threaded storage on a shared static layer (the sequential
+Terrain). Every access is a plain load or store: the bitplanes are read
+with relaxed order and written with store_exclusive().
+*/
+class LayerStorage {
+public:
+    static constexpr bool thread_safe = false;
+
+    // Information gain is only allocated on the first query, so a
+    // random-walk run stays at one bit per cell.
+    static constexpr bool lazy_gain = true;
+
+    LayerStorage(int w, int h)
+        : LayerStorage(std::make_shared<StaticTerrainLayer>(w, h), true)
+    {
+    }
+
+    // A fresh, unvisited storage on an existing (shared) static layer.
+    explicit LayerStorage(std::shared_ptr<const StaticTerrainLayer> layer)
+        : LayerStorage(std::move(layer), false)
+    {
+    }
+
+    int width() const {
+        return static_->width_;
+    }
+
+    int height() const {
+        return static_->height_;
+    }
+
+    std::shared_ptr<const StaticTerrainLayer> static_layer() const {
+        return static_;
+    }
+
+    CellType type_at(std::size_t cell_index) const {
+        return cell_type(static_->cells_[cell_index]);
+    }
+
+    bool visited(const Position& pos) const {
+        return visited_.test(pos, std::memory_order_relaxed);
+    }
+
+    // Obstacle or visited (or outside), as a 3x3 window.
+    std::uint32_t blocked_window(const Position& pos) const {
+        return obstacle_window(pos) |
+               visited_.window(pos, std::memory_order_relaxed);
+    }
+
+    // Obstacle (or outside), as a 3x3 window.
+    std::uint32_t obstacle_window(const Position& pos) const {
+        return static_->obstacle_plane_.window(pos, std::memory_order_relaxed);
+    }
+
+    // True when pos was not visited before.
+    bool claim(const Position& pos) {
+        if (visited(pos)) {
+            return false;
+        }
+
+        visited_.store_exclusive(pos, true);
+        return true;
+    }
+
+    void unclaim_exclusive(const Position& pos) {
+        visited_.store_exclusive(pos, false);
+    }
+
+    void store_type(const Position& pos, std::size_t cell_index, CellType type) {
+        StaticTerrainLayer& layer = mutable_layer();
+
+        layer.cells_[cell_index] = pack_cell(type, false);
+        layer.obstacle_plane_.store_exclusive(pos, type == CellType::Obstacle);
+    }
+
+    void store_type_exclusive(const Position& pos,
+                              std::size_t cell_index,
+                              CellType type)
+    {
+        store_type(pos, cell_index, type);
+    }
+
+    std::optional<Position> target() const {
+        return static_->target_;
+    }
+
+    void set_target(const std::optional<Position>& target) {
+        if (!(static_->target_ == target)) {
+            mutable_layer().target_ = target;
+        }
+    }
+
+    // Padded row `padded_y` of obstacle | visited into out[0, stride).
+    void copy_blocked_row(int padded_y, std::uint64_t* out) const {
+        static_->obstacle_plane_.copy_row(padded_y, out);
+        visited_.or_row(padded_y, out);
+    }
+
+    std::size_t stride() const {
+        return visited_.stride();
+    }
+
+    // The gain field is derived data (a cache of neighbor counts), so
+    // building it is allowed on a const storage.
+    bool has_gain() const {
+        return !gain_.empty();
+    }
+
+    void allocate_gain() const {
+        gain_.assign(static_->cells_.size(), 0);
+    }
+
+    void store_gain(std::size_t cell_index, std::uint8_t value) const {
+        gain_[cell_index] = value;
+    }
+
+    int gain(std::size_t cell_index) const {
+        return gain_[cell_index];
+    }
+
+    void add_gain(std::size_t cell_index, int delta) {
+        gain_[cell_index] = static_cast<std::uint8_t>(gain_[cell_index] + delta);
+    }
+
+    void add_gain_exclusive(std::size_t cell_index, int delta) {
+        add_gain(cell_index, delta);
+    }
+
+    void append_visited(const Position& pos, std::size_t /*cell_index*/) {
+        journal_.push_back(pos);
+    }
+
+    std::size_t visited_count() const {
+        return journal_.size();
+    }
+
+    std::size_t visited_since(std::size_t epoch,
+                              std::vector<Position>& out,
+                              std::size_t limit) const
+    {
+        const std::size_t end = std::min(journal_.size(), limit);
+
+        for (std::size_t i = epoch; i < end; ++i) {
+            out.push_back(journal_[i]);
+        }
+
+        return std::max(epoch, end);
+    }
+
+    // Calls on_cell(pos) for every journal entry, then empties it.
+    template <typename Function>
+    void drain_visited_exclusive(Function&& on_cell) {
+        for (const auto& pos : journal_) {
+            on_cell(pos);
+        }
+
+        journal_.clear();
+    }
+
+    // Heap bytes of the cell-type grid (one PackedCell per cell), shared
+    // by every terrain on the same static layer.
+    std::size_t storage_bytes() const {
+        return static_->cells_.capacity() * sizeof(PackedCell);
+    }
+
+    // Heap bytes owned on top of the static layer: the visited bitplane,
+    // plus one byte per cell once the gain has been built. The visit
+    // journal is not included.
+    std::size_t owned_storage_bytes() const {
+        return visited_.storage_bytes() +
+               gain_.capacity() * sizeof(std::uint8_t);
+    }
+
+private:
+    LayerStorage(std::shared_ptr<const StaticTerrainLayer> layer,
+                 bool owns_layer)
+        : static_(std::move(layer)),
+          owns_layer_(owns_layer),
+          visited_(static_->width_, static_->height_, false)
+    {
+    }
+
+    // Copy-on-write: the layer is copied first unless this storage is
+    // its only user.
+    StaticTerrainLayer& mutable_layer() {
+        if (owns_layer_ && static_.use_count() == 1) {
+            // Pairs with the release in the last other owner's
+            // shared_ptr destructor: its reads of the layer are done.
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } else {
+            static_ = std::make_shared<StaticTerrainLayer>(*static_);
+            owns_layer_ = true;
+        }
+
+        return const_cast<StaticTerrainLayer&>(*static_);
+    }
+
+    // Cell types, obstacle plane and target, see StaticTerrainLayer.
+    std::shared_ptr<const StaticTerrainLayer> static_;
+
+    // True when the layer was created by a storage (never a const
+    // object), so it may be written in place once nobody shares it.
+    bool owns_layer_;
+
+    // Border = 0.
+    Bitboard visited_;
+
+    // Empty until the gain is first needed, see lazy_gain.
+    mutable std::vector<std::uint8_t> gain_;
+
+    // Visited cells in visit order.
+    std::vector<Position> journal_;
+};
+
+
+/*
+Shared-memory storage (the parallel terrain): every word several
+threads may touch is an atomic.
+
+    claim()            one fetch_or on the visited word: exactly one
+                       caller sees the bit go from 0 to 1
+    blocked_window()   acquire loads of 3 + 3 bitplane words
+    add_gain()         relaxed fetch_add / fetch_sub
+    append_visited()   fetch_add a slot, then a release store
+
+The *_exclusive variants are for setup, when the caller is the only
+writer: plain relaxed loads and stores instead of read-modify-writes.
+*/
+class AtomicStorage {
+public:
+    static constexpr bool thread_safe = true;
+    static constexpr bool lazy_gain = false;
+
+    AtomicStorage(int w, int h)
+        : width_(w),
+          height_(h),
+          cell_count_(static_cast<std::size_t>(w) *
+                      static_cast<std::size_t>(h)),
+          // make_unique<T[]> value-initializes: every byte starts as
+          // pack_cell(CellType::Free, false) == 0.
+          cells_(std::make_unique<std::atomic<PackedCell>[]>(cell_count_)),
+          obstacle_plane_(w, h, true),
+          visited_plane_(w, h, false),
+          gain_(std::make_unique<std::atomic<std::uint8_t>[]>(cell_count_)),
+          journal_(std::make_unique<std::atomic<std::uint32_t>[]>(cell_count_))
+    {
+        if (cell_count_ >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("Terrain has too many cells");
+        }
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    // Cell types only change during setup.
+    CellType type_at(std::size_t cell_index) const {
+        return cell_type(cells_[cell_index].load(std::memory_order_acquire));
+    }
+
+    bool visited(const Position& pos) const {
+        return visited_plane_.test(pos);
+    }
+
+    std::uint32_t blocked_window(const Position& pos) const {
+        return obstacle_plane_.window(pos) | visited_plane_.window(pos);
+    }
+
+    std::uint32_t obstacle_window(const Position& pos) const {
+        return obstacle_plane_.window(pos);
+    }
+
+    bool claim(const Position& pos) {
+        return visited_plane_.set(pos);
+    }
+
+    void unclaim_exclusive(const Position& pos) {
+        visited_plane_.store_exclusive(pos, false);
+    }
+
+    void store_type(const Position& pos, std::size_t cell_index, CellType type) {
+        cells_[cell_index].store(
+            pack_cell(type, false),
+            std::memory_order_release
+        );
+
+        if (type == CellType::Obstacle) {
+            obstacle_plane_.set(pos);
+        } else {
+            obstacle_plane_.clear(pos);
+        }
+    }
+
+    void store_type_exclusive(const Position& pos,
+                              std::size_t cell_index,
+                              CellType type)
+    {
+        cells_[cell_index].store(
+            pack_cell(type, false),
+            std::memory_order_relaxed
+        );
+
+        obstacle_plane_.store_exclusive(pos, type == CellType::Obstacle);
+    }
+
+    // Guarded by the terrain's static mutex.
+    std::optional<Position> target() const {
+        return target_;
+    }
+
+    void set_target(const std::optional<Position>& target) {
+        target_ = target;
+    }
+
+    void copy_blocked_row(int padded_y, std::uint64_t* out) const {
+        obstacle_plane_.copy_row(padded_y, out);
+        visited_plane_.or_row(padded_y, out);
+    }
+
+    std::size_t stride() const {
+        return visited_plane_.stride();
+    }
+
+    // Allocated with the storage.
+    bool has_gain() const {
+        return true;
+    }
+
+    void allocate_gain() const {
+    }
+
+    void store_gain(std::size_t cell_index, std::uint8_t value) const {
+        gain_[cell_index].store(value, std::memory_order_relaxed);
+    }
+
+    int gain(std::size_t cell_index) const {
+        return gain_[cell_index].load(std::memory_order_relaxed);
+    }
+
+    void add_gain(std::size_t cell_index, int delta) {
+        if (delta > 0) {
+            gain_[cell_index].fetch_add(
+                static_cast<std::uint8_t>(delta),
+                std::memory_order_relaxed
+            );
+        } else {
+            gain_[cell_index].fetch_sub(
+                static_cast<std::uint8_t>(-delta),
+                std::memory_order_relaxed
+            );
+        }
+    }
+
+    void add_gain_exclusive(std::size_t cell_index, int delta) {
+        std::atomic<std::uint8_t>& gain = gain_[cell_index];
+
+        gain.store(
+            static_cast<std::uint8_t>(
+                gain.load(std::memory_order_relaxed) + delta
+            ),
+            std::memory_order_relaxed
+        );
+    }
+
+
+    /*
+    Visited journal.
+
+    Every cell is visited at most once, so the storage keeps an
+    append-only log of visited cells with room for exactly one entry
+    per cell:
+
+        journal_   [ (0,0) | (3,0) | (0,3) | (1,1) | (2,1) |  0  |  0 ... ]
+                     0       1       2       3       4       ^
+                                                             journal_size_
+
+    Appending reserves a slot with fetch_add and then publishes the
+    entry (cell index + 1) with a release store. An entry of 0 means
+    "reserved, not yet written": the reader stops there and returns
+    that epoch, so nothing is ever skipped. Reading takes no lock.
+    */
+    void append_visited(const Position& /*pos*/, std::size_t cell_index) {
+        const std::size_t slot =
+            journal_size_.fetch_add(1, std::memory_order_relaxed);
+
+        journal_[slot].store(
+            static_cast<std::uint32_t>(cell_index + 1),
+            std::memory_order_release
+        );
+    }
+
+    // Number of visited cells (including entries still being written).
+    std::size_t visited_count() const {
+        return journal_size_.load(std::memory_order_acquire);
+    }
+
+    std::size_t visited_since(std::size_t epoch,
+                              std::vector<Position>& out,
+                              std::size_t limit) const
+    {
+        const std::size_t end = std::min(
+            journal_size_.load(std::memory_order_acquire),
+            limit
+        );
+
+        std::size_t current = epoch;
+
+        for (; current < end; ++current) {
+            const std::uint32_t entry =
+                journal_[current].load(std::memory_order_acquire);
+
+            if (entry == 0) {
+                break;
+            }
+
+            out.push_back(position_of(entry - 1));
+        }
+
+        return current;
+    }
+
+    template <typename Function>
+    void drain_visited_exclusive(Function&& on_cell) {
+        const std::size_t visited =
+            journal_size_.load(std::memory_order_acquire);
+
+        for (std::size_t i = 0; i < visited; ++i) {
+            const std::size_t cell_index =
+                journal_[i].load(std::memory_order_relaxed) - 1;
+
+            journal_[i].store(0, std::memory_order_relaxed);
+
+            on_cell(position_of(cell_index));
+        }
+
+        journal_size_.store(0, std::memory_order_release);
+    }
+
+    // Heap bytes owned by the cell grid (one PackedCell per cell).
+    // The information-gain field adds another byte per cell, the
+    // obstacle and visited bitplanes one bit each.
+    std::size_t storage_bytes() const {
+        return cell_count_ * sizeof(std::atomic<PackedCell>);
+    }
+
+    std::size_t owned_storage_bytes() const {
+        return storage_bytes() +
+               obstacle_plane_.storage_bytes() +
+               visited_plane_.storage_bytes() +
+               cell_count_ * sizeof(std::atomic<std::uint8_t>) +
+               cell_count_ * sizeof(std::atomic<std::uint32_t>);
+    }
+
+private:
+    Position position_of(std::size_t cell_index) const {
+        const std::size_t width = static_cast<std::size_t>(width_);
+
+        return Position{
+            static_cast<int>(cell_index % width),
+            static_cast<int>(cell_index / width)
+        };
+    }
+
+    int width_;
+    int height_;
+    std::size_t cell_count_;
+
+    // Row-major: cells_[y * width_ + x]. See packed_cell.hpp.
+    // std::atomic is neither copyable nor movable, so it cannot live in
+    // a std::vector that might reallocate; the buffer size is fixed.
+    // Only the CellType bits are used: visited state is in
+    // visited_plane_.
+    std::unique_ptr<std::atomic<PackedCell>[]> cells_;
+
+    // One bit per cell with a sentinel border, see bitboard.hpp.
+    // obstacle_plane_ mirrors the Obstacle cell type (border = 1).
+    // visited_plane_ is the authoritative visited flag (border = 0).
+    Bitboard obstacle_plane_;
+    Bitboard visited_plane_;
+
+    // Incrementally maintained information gain, same indexing as
+    // cells_. At most 8, so one byte per cell is enough.
+    std::unique_ptr<std::atomic<std::uint8_t>[]> gain_;
+
+    // Entries are cell index + 1, see append_visited().
+    std::unique_ptr<std::atomic<std::uint32_t>[]> journal_;
+    std::atomic<std::size_t> journal_size_{0};
+
+    std::optional<Position> target_;
+
+    static_assert(sizeof(std::atomic<PackedCell>) == sizeof(PackedCell),
+                  "atomic cells must stay one byte");
+    static_assert(pack_cell(CellType::Free, false) == 0,
+                  "value-initialized cells must be free and unvisited");
+};
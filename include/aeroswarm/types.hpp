@@ -1,6 +1,11 @@
 #pragma once
 
-enum class CellType {
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Stored in two bits of a PackedCell (see packed_cell.hpp).
+enum class CellType : std::uint8_t {
     Free,
     Obstacle,
     Target
@@ -29,3 +34,10 @@ struct Cell {
 };
 
 
+/*
+An immutable position list shared by reference.
+
+Used for the static layers of a terrain (obstacles): built once, then
+every snapshot points at the same buffer instead of copying it.
+*/
+using SharedPositions = std::shared_ptr<const std::vector<Position>>;
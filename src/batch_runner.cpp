@@ -0,0 +1,469 @@
+#include "aeroswarm/app/batch_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <thread>
+
+#include "aeroswarm/app/scenario_factory.hpp"
+#include "aeroswarm/parallel/simulation.hpp"
+#include "aeroswarm/parallel/terrain.hpp"
+#include "aeroswarm/sequential/simulation.hpp"
+#include "aeroswarm/sequential/terrain.hpp"
+#include "aeroswarm/stop_token.hpp"
+
+namespace {
+
+struct RunSpec {
+    std::size_t run_index;
+    std::size_t config_index;
+    int map_size;
+    int drone_count;
+    unsigned int seed;
+};
+
+
+/*
+Run index layout:
+
+    index = config_index * seeds_per_config + seed_offset
+    config_index = size_index * drone_counts.size() + drone_index
+
+so a run is fully described by its index and no run list is stored.
+*/
+RunSpec decode_run(const BatchConfig& config, std::size_t run_index) {
+    const std::size_t config_index = run_index / config.seeds_per_config;
+    const std::size_t seed_offset = run_index % config.seeds_per_config;
+
+    const std::size_t size_index =
+        config_index / config.drone_counts.size();
+
+    const std::size_t drone_index =
+        config_index % config.drone_counts.size();
+
+    return RunSpec{
+        run_index,
+        config_index,
+        config.map_sizes[size_index],
+        config.drone_counts[drone_index],
+        config.first_seed + static_cast<unsigned int>(seed_offset)
+    };
+}
+
+
+Deadline run_deadline(const BatchConfig& config) {
+    if (config.run_time_limit.count() <= 0) {
+        return std::nullopt;
+    }
+
+    return std::chrono::steady_clock::now() + config.run_time_limit;
+}
+
+
+/*
+Each pool thread keeps its terrain between runs. Runs are numbered
+configuration by configuration, so the map size rarely changes and
+most runs only reset the previous terrain:
+
+    same size        reset_visited() + set_target() + set_obstacles()
+    different size   allocate a new terrain
+
+Simulation owns its terrain, so the sequential one is moved into the
+run and handed back by release_terrain() afterwards.
+*/
+Terrain prepare_terrain(std::optional<Terrain>& terrain,
+                        const Scenario& scenario)
+{
+    if (!terrain ||
+        terrain->width() != scenario.width ||
+        terrain->height() != scenario.height) {
+        terrain.emplace(scenario.width, scenario.height);
+    } else {
+        terrain->reset_visited();
+    }
+
+    terrain->set_target(scenario.target);
+    terrain->set_obstacles(scenario.obstacles);
+
+    Terrain prepared = std::move(*terrain);
+    terrain.reset();
+
+    return prepared;
+}
+
+
+BatchRunResult run_sequential_once(const BatchConfig& config,
+                                   const Scenario& scenario,
+                                   std::optional<Terrain>& reusable)
+{
+    BatchRunResult result;
+
+    Simulation simulation{
+        prepare_terrain(reusable, scenario),
+        scenario.drones,
+        scenario.seed,
+        config.recovery
+    };
+
+    const auto status =
+        simulation.run_until_done({}, run_deadline(config));
+
+    result.ticks = simulation.tick();
+    result.winning_drone_id = simulation.winning_drone_id();
+    result.visited_cells = simulation.terrain().visited_count();
+
+    if (status == SimulationStatus::TargetFound) {
+        result.status = BatchRunStatus::TargetFound;
+        result.winning_tick = simulation.tick();
+    } else if (status == SimulationStatus::DeadlineExceeded) {
+        result.status = BatchRunStatus::DeadlineExceeded;
+    }
+
+    reusable.emplace(simulation.release_terrain());
+
+    return result;
+}
+
+
+// Same reuse for the parallel engine, which borrows its terrain.
+ParallelTerrain& prepare_terrain(std::unique_ptr<ParallelTerrain>& terrain,
+                                 const Scenario& scenario)
+{
+    if (!terrain ||
+        terrain->width() != scenario.width ||
+        terrain->height() != scenario.height) {
+        terrain = std::make_unique<ParallelTerrain>(
+            scenario.width,
+            scenario.height,
+            TerrainSynchronization::LockFree
+        );
+    } else {
+        terrain->reset_visited();
+    }
+
+    terrain->set_target(scenario.target);
+    terrain->set_obstacles(scenario.obstacles);
+
+    return *terrain;
+}
+
+
+BatchRunResult run_parallel_once(const BatchConfig& config,
+                                 const Scenario& scenario,
+                                 std::unique_ptr<ParallelTerrain>& reusable)
+{
+    BatchRunResult result;
+
+    ParallelTerrain& terrain = prepare_terrain(reusable, scenario);
+
+    ParallelSimulationOptions options;
+    options.execution = ParallelExecution::Lockstep;
+    options.worker_threads = 1;
+    options.recovery = config.recovery;
+
+    ParallelSimulation simulation{
+        terrain,
+        scenario.drones,
+        scenario.seed,
+        options
+    };
+
+    const auto status = simulation.run({}, run_deadline(config));
+
+    // Empty visited delta: only the counters are needed.
+    result.ticks = simulation.snapshot(terrain.visited_count()).tick;
+    result.winning_drone_id = simulation.winning_drone_id();
+    result.winning_tick = simulation.winning_tick();
+    result.visited_cells = terrain.visited_count();
+
+    if (status == ParallelSimulationStatus::TargetFound) {
+        result.status = BatchRunStatus::TargetFound;
+    } else if (status == ParallelSimulationStatus::DeadlineExceeded) {
+        result.status = BatchRunStatus::DeadlineExceeded;
+    }
+
+    return result;
+}
+
+
+const char* status_name(BatchRunStatus status) {
+    switch (status) {
+        case BatchRunStatus::TargetFound:
+            return "target_found";
+        case BatchRunStatus::Stuck:
+            return "stuck";
+        case BatchRunStatus::DeadlineExceeded:
+            return "deadline_exceeded";
+    }
+
+    return "unknown";
+}
+
+
+// Formats into a per-thread buffer, so only the write itself happens
+// under the output lock.
+void format_csv_row(std::string& row, const BatchRunResult& result) {
+    row.clear();
+
+    row += std::to_string(result.run_index);
+    row += ',';
+    row += std::to_string(result.map_size);
+    row += ',';
+    row += std::to_string(result.drone_count);
+    row += ',';
+    row += std::to_string(result.seed);
+    row += ',';
+    row += status_name(result.status);
+    row += ',';
+    row += std::to_string(result.ticks);
+    row += ',';
+
+    if (result.winning_tick.has_value()) {
+        row += std::to_string(result.winning_tick.value());
+    }
+
+    row += ',';
+
+    if (result.winning_drone_id.has_value()) {
+        row += std::to_string(result.winning_drone_id.value());
+    }
+
+    row += ',';
+    row += std::to_string(result.visited_cells);
+    row += ',';
+    row += std::to_string(result.wall_ms);
+    row += '\n';
+}
+
+
+void accumulate(BatchConfigSummary& summary, const BatchRunResult& result) {
+    ++summary.runs;
+
+    if (result.status == BatchRunStatus::TargetFound &&
+        result.winning_tick.has_value()) {
+        const auto ticks =
+            static_cast<double>(result.winning_tick.value());
+
+        ++summary.target_found;
+        summary.ticks_to_target.add(ticks);
+        summary.ticks_to_target_p50.add(ticks);
+        summary.ticks_to_target_p90.add(ticks);
+        summary.ticks_to_target_p99.add(ticks);
+    }
+
+    summary.visited_cells.add(static_cast<double>(result.visited_cells));
+    summary.wall_ms.add(result.wall_ms);
+}
+
+} // namespace
+
+
+const char* batch_csv_header() {
+    return "run,map_size,drones,seed,status,ticks,winning_tick,"
+           "winning_drone,visited_cells,wall_ms";
+}
+
+
+BatchSummary run_batch(const BatchConfig& config, std::ostream* csv) {
+    BatchSummary summary;
+
+    for (const int size : config.map_sizes) {
+        for (const int drones : config.drone_counts) {
+            BatchConfigSummary entry;
+            entry.map_size = size;
+            entry.drone_count = drones;
+            summary.configs.push_back(entry);
+        }
+    }
+
+    const std::size_t total_runs =
+        summary.configs.size() * config.seeds_per_config;
+
+    if (csv != nullptr) {
+        *csv << batch_csv_header() << '\n';
+    }
+
+    if (total_runs == 0) {
+        return summary;
+    }
+
+    std::size_t thread_count = config.worker_threads;
+
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+
+    thread_count = std::max<std::size_t>(
+        1,
+        std::min(thread_count, total_runs)
+    );
+
+    // Runs are independent and of similar cost: a shared counter hands
+    // out the next one, idle threads never wait for a slow neighbour.
+    std::atomic<std::size_t> next_run{0};
+
+    // Guards the CSV stream and the summaries.
+    std::mutex output_mutex;
+
+    const auto worker = [&]() {
+        std::string row;
+        std::optional<Terrain> terrain;
+        std::unique_ptr<ParallelTerrain> parallel_terrain;
+
+        while (true) {
+            const std::size_t run_index = next_run.fetch_add(1);
+
+            if (run_index >= total_runs) {
+                return;
+            }
+
+            const RunSpec spec = decode_run(config, run_index);
+
+            const int obstacles = static_cast<int>(
+                config.obstacle_density *
+                static_cast<double>(spec.map_size) *
+                static_cast<double>(spec.map_size)
+            );
+
+            const Scenario scenario = make_random_scenario(
+                spec.map_size,
+                spec.map_size,
+                obstacles,
+                spec.seed,
+                spec.drone_count
+            );
+
+            const auto start = std::chrono::steady_clock::now();
+
+            BatchRunResult result =
+                config.engine == BatchEngine::Sequential
+                    ? run_sequential_once(config, scenario, terrain)
+                    : run_parallel_once(config, scenario, parallel_terrain);
+
+            const auto stop = std::chrono::steady_clock::now();
+
+            result.run_index = spec.run_index;
+            result.map_size = spec.map_size;
+            result.drone_count = spec.drone_count;
+            result.seed = spec.seed;
+            result.wall_ms =
+                std::chrono::duration<double, std::milli>(stop - start)
+                    .count();
+
+            if (csv != nullptr) {
+                format_csv_row(row, result);
+            }
+
+            std::lock_guard<std::mutex> lock(output_mutex);
+
+            if (csv != nullptr) {
+                *csv << row;
+            }
+
+            accumulate(summary.configs[spec.config_index], result);
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back(worker);
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    summary.wall_seconds =
+        std::chrono::duration<double>(stop - start).count();
+
+    if (csv != nullptr) {
+        csv->flush();
+    }
+
+    return summary;
+}
+
+
+int run_batch_mode(const BatchConfig& config, const std::string& csv_path) {
+    std::ofstream csv_file;
+
+    if (!csv_path.empty()) {
+        csv_file.open(csv_path);
+
+        if (!csv_file) {
+            std::cerr << "Cannot open " << csv_path << " for writing\n";
+            return 1;
+        }
+    }
+
+    const BatchSummary summary =
+        run_batch(config, csv_path.empty() ? nullptr : &csv_file);
+
+    std::size_t total_runs = 0;
+
+    std::cout
+        << "size  drones   runs  found%   ticks-to-target"
+        << " mean / p50 / p90 / p99   visited%   wall ms mean\n";
+
+    for (const auto& entry : summary.configs) {
+        total_runs += entry.runs;
+
+        const double found_percent = entry.runs == 0
+            ? 0.0
+            : 100.0 * static_cast<double>(entry.target_found) /
+              static_cast<double>(entry.runs);
+
+        // Mean coverage: visited cells over all cells of the map.
+        const double visited_percent =
+            100.0 * entry.visited_cells.mean() /
+            (static_cast<double>(entry.map_size) *
+             static_cast<double>(entry.map_size));
+
+        std::cout
+            << std::setw(4) << entry.map_size
+            << std::setw(8) << entry.drone_count
+            << std::setw(7) << entry.runs
+            << std::setw(8) << std::fixed << std::setprecision(1)
+            << found_percent
+            << "   "
+            << std::setw(8) << entry.ticks_to_target.mean() << " / "
+            << std::setw(6) << entry.ticks_to_target_p50.value() << " / "
+            << std::setw(6) << entry.ticks_to_target_p90.value() << " / "
+            << std::setw(6) << entry.ticks_to_target_p99.value()
+            << "   "
+            << std::setw(8) << visited_percent
+            << "   "
+            << std::setw(9) << std::setprecision(3)
+            << entry.wall_ms.mean() << '\n';
+    }
+
+    std::cout
+        << total_runs << " runs in "
+        << std::setprecision(2) << summary.wall_seconds << " s";
+
+    if (summary.wall_seconds > 0.0) {
+        std::cout
+            << " (" << std::setprecision(0)
+            << static_cast<double>(total_runs) / summary.wall_seconds
+            << " runs/s)";
+    }
+
+    std::cout << '\n';
+
+    if (!csv_path.empty()) {
+        std::cout << "Per-run results: " << csv_path << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,419 @@
+#include "aeroswarm/bitboard.hpp"
+
+#include <cstring>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AEROSWARM_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+
+Bitboard::Bitboard(int width, int height, bool border)
+    : width_(width),
+      height_(height),
+      stride_((static_cast<std::size_t>(width) + 2 + 63) / 64),
+      word_count_(stride_ * (static_cast<std::size_t>(height) + 2)),
+      words_(std::make_unique<std::atomic<std::uint64_t>[]>(word_count_))
+{
+    if (!border) {
+        return;
+    }
+
+    // Whole top and bottom padded rows, then column 0 and everything
+    // right of the last cell (width + 1 up to the end of the row).
+    for (std::size_t i = 0; i < stride_; ++i) {
+        words_[i].store(~std::uint64_t{0}, std::memory_order_relaxed);
+        words_[word_count_ - stride_ + i].store(
+            ~std::uint64_t{0},
+            std::memory_order_relaxed
+        );
+    }
+
+    const std::size_t first_right = static_cast<std::size_t>(width) + 1;
+
+    for (int y = 1; y <= height; ++y) {
+        const std::size_t base = static_cast<std::size_t>(y) * stride_;
+
+        for (std::size_t i = 0; i < stride_; ++i) {
+            std::uint64_t word = 0;
+
+            for (std::size_t bit = 0; bit < 64; ++bit) {
+                const std::size_t column = i * 64 + bit;
+
+                if (column == 0 || column >= first_right) {
+                    word |= std::uint64_t{1} << bit;
+                }
+            }
+
+            words_[base + i].store(word, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+Bitboard::Bitboard(const Bitboard& other)
+    : width_(other.width_),
+      height_(other.height_),
+      stride_(other.stride_),
+      word_count_(other.word_count_),
+      words_(std::make_unique<std::atomic<std::uint64_t>[]>(word_count_))
+{
+    for (std::size_t i = 0; i < word_count_; ++i) {
+        words_[i].store(
+            other.words_[i].load(std::memory_order_relaxed),
+            std::memory_order_relaxed
+        );
+    }
+}
+
+
+Bitboard& Bitboard::operator=(const Bitboard& other) {
+    if (this != &other) {
+        Bitboard copy{other};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+
+namespace {
+
+// Carry-save add of one neighbor plane into the 4 count planes.
+inline void add_plane(std::uint64_t (&sum)[4], std::uint64_t bits) {
+    const std::uint64_t carry0 = sum[0] & bits;
+    sum[0] ^= bits;
+
+    const std::uint64_t carry1 = sum[1] & carry0;
+    sum[1] ^= carry0;
+
+    const std::uint64_t carry2 = sum[2] & carry1;
+    sum[2] ^= carry1;
+
+    // At most 8 neighbors: bit 3 never carries further.
+    sum[3] |= carry2;
+}
+
+
+// expand_bits[b]: the 8 bits of b as 8 bytes of 0 or 1, lowest bit in
+// the lowest byte (little-endian memcpy order).
+struct ExpandTable {
+    std::uint64_t bytes[256];
+
+    constexpr ExpandTable() : bytes{} {
+        for (unsigned b = 0; b < 256; ++b) {
+            std::uint64_t value = 0;
+
+            for (unsigned bit = 0; bit < 8; ++bit) {
+                if ((b >> bit) & 1u) {
+                    value |= std::uint64_t{1} << (8 * bit);
+                }
+            }
+
+            bytes[b] = value;
+        }
+    }
+};
+
+constexpr ExpandTable expand_bits{};
+
+
+void count_word_scalar(const std::uint64_t* above,
+                       const std::uint64_t* row,
+                       const std::uint64_t* below,
+                       std::size_t w,
+                       std::uint32_t neighbors,
+                       std::uint8_t* out)
+{
+    // Column c - 1 (west) and c + 1 (east) of every column c in word w.
+    const auto west = [w](const std::uint64_t* r) {
+        return (r[w] << 1) | (r[w - 1] >> 63);
+    };
+
+    const auto east = [w](const std::uint64_t* r) {
+        return (r[w] >> 1) | (r[w + 1] << 63);
+    };
+
+    // Window bit k of `neighbors` enables plane k; bit 4 is the cell
+    // itself and never counts.
+    const std::uint64_t planes[9] = {
+        ~west(above), ~above[w], ~east(above),
+        ~west(row),   0,         ~east(row),
+        ~west(below), ~below[w], ~east(below)
+    };
+
+    std::uint64_t sum[4] = {0, 0, 0, 0};
+
+    for (unsigned k = 0; k < 9; ++k) {
+        if ((neighbors >> k) & 1u) {
+            add_plane(sum, planes[k]);
+        }
+    }
+
+    for (unsigned byte = 0; byte < 8; ++byte) {
+        const unsigned shift = byte * 8;
+
+        const std::uint64_t counts =
+            expand_bits.bytes[(sum[0] >> shift) & 0xFF] |
+            (expand_bits.bytes[(sum[1] >> shift) & 0xFF] << 1) |
+            (expand_bits.bytes[(sum[2] >> shift) & 0xFF] << 2) |
+            (expand_bits.bytes[(sum[3] >> shift) & 0xFF] << 3);
+
+        std::memcpy(out + w * 64 + shift, &counts, sizeof(counts));
+    }
+}
+
+
+void count_scalar(const std::uint64_t* above,
+                  const std::uint64_t* row,
+                  const std::uint64_t* below,
+                  std::size_t words,
+                  std::uint32_t neighbors,
+                  std::uint8_t* out)
+{
+    for (std::size_t w = 0; w < words; ++w) {
+        count_word_scalar(above, row, below, w, neighbors, out);
+    }
+}
+
+
+#if defined(AEROSWARM_AVX2_KERNEL)
+
+/*
+Same kernel on 4 words (256 columns) per step.
+
+Lambdas and templates would not inherit target("avx2"), so every helper
+is a plain function with the attribute.
+*/
+__attribute__((target("avx2")))
+inline __m256i load4(const std::uint64_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+// The unaligned loads at w - 1 and w + 1 bring in the neighbouring word
+// of every lane, so no cross-lane shuffle is needed.
+__attribute__((target("avx2")))
+inline __m256i open_west4(const std::uint64_t* r, std::size_t w) {
+    const __m256i blocked = _mm256_or_si256(
+        _mm256_slli_epi64(load4(r + w), 1),
+        _mm256_srli_epi64(load4(r + w - 1), 63)
+    );
+
+    return _mm256_xor_si256(blocked, _mm256_set1_epi64x(-1));
+}
+
+__attribute__((target("avx2")))
+inline __m256i open_east4(const std::uint64_t* r, std::size_t w) {
+    const __m256i blocked = _mm256_or_si256(
+        _mm256_srli_epi64(load4(r + w), 1),
+        _mm256_slli_epi64(load4(r + w + 1), 63)
+    );
+
+    return _mm256_xor_si256(blocked, _mm256_set1_epi64x(-1));
+}
+
+__attribute__((target("avx2")))
+inline __m256i open4(const std::uint64_t* r, std::size_t w) {
+    return _mm256_xor_si256(load4(r + w), _mm256_set1_epi64x(-1));
+}
+
+__attribute__((target("avx2")))
+inline void add_plane4(__m256i (&sum)[4], __m256i bits) {
+    const __m256i carry0 = _mm256_and_si256(sum[0], bits);
+    sum[0] = _mm256_xor_si256(sum[0], bits);
+
+    const __m256i carry1 = _mm256_and_si256(sum[1], carry0);
+    sum[1] = _mm256_xor_si256(sum[1], carry0);
+
+    const __m256i carry2 = _mm256_and_si256(sum[2], carry1);
+    sum[2] = _mm256_xor_si256(sum[2], carry1);
+
+    sum[3] = _mm256_or_si256(sum[3], carry2);
+}
+
+
+/*
+32 bits -> 32 bytes of `weight` or 0.
+
+Each 128-bit lane picks the two source bytes its 16 output bytes come
+from (shuffle_epi8 only works inside a lane), then every output byte
+tests "its" bit with a 0x01, 0x02, ... 0x80 mask.
+*/
+__attribute__((target("avx2")))
+inline __m256i expand_to_bytes(std::uint32_t bits, __m256i weight) {
+    const __m256i source = _mm256_set1_epi32(static_cast<int>(bits));
+
+    const __m256i pick = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3
+    );
+
+    const __m256i select = _mm256_set1_epi64x(
+        static_cast<long long>(0x8040201008040201ULL)
+    );
+
+    const __m256i spread = _mm256_shuffle_epi8(source, pick);
+
+    const __m256i set = _mm256_cmpeq_epi8(
+        _mm256_and_si256(spread, select),
+        select
+    );
+
+    return _mm256_and_si256(set, weight);
+}
+
+
+__attribute__((target("avx2")))
+void count_avx2(const std::uint64_t* above,
+                const std::uint64_t* row,
+                const std::uint64_t* below,
+                std::size_t words,
+                std::uint32_t neighbors,
+                std::uint8_t* out)
+{
+    const __m256i weights[4] = {
+        _mm256_set1_epi8(1),
+        _mm256_set1_epi8(2),
+        _mm256_set1_epi8(4),
+        _mm256_set1_epi8(8)
+    };
+
+    std::size_t w = 0;
+
+    for (; w + 4 <= words; w += 4) {
+        __m256i sum[4] = {
+            _mm256_setzero_si256(),
+            _mm256_setzero_si256(),
+            _mm256_setzero_si256(),
+            _mm256_setzero_si256()
+        };
+
+        // Same window bits as count_word_scalar().
+        if (neighbors & 0x001u) {
+            add_plane4(sum, open_west4(above, w));
+        }
+
+        if (neighbors & 0x002u) {
+            add_plane4(sum, open4(above, w));
+        }
+
+        if (neighbors & 0x004u) {
+            add_plane4(sum, open_east4(above, w));
+        }
+
+        if (neighbors & 0x008u) {
+            add_plane4(sum, open_west4(row, w));
+        }
+
+        if (neighbors & 0x020u) {
+            add_plane4(sum, open_east4(row, w));
+        }
+
+        if (neighbors & 0x040u) {
+            add_plane4(sum, open_west4(below, w));
+        }
+
+        if (neighbors & 0x080u) {
+            add_plane4(sum, open4(below, w));
+        }
+
+        if (neighbors & 0x100u) {
+            add_plane4(sum, open_east4(below, w));
+        }
+
+        alignas(32) std::uint32_t planes[4][8];
+
+        for (int k = 0; k < 4; ++k) {
+            _mm256_store_si256(
+                reinterpret_cast<__m256i*>(planes[k]),
+                sum[k]
+            );
+        }
+
+        // 256 columns, 32 per step.
+        for (int part = 0; part < 8; ++part) {
+            __m256i counts = expand_to_bytes(planes[0][part], weights[0]);
+
+            for (int k = 1; k < 4; ++k) {
+                counts = _mm256_or_si256(
+                    counts,
+                    expand_to_bytes(planes[k][part], weights[k])
+                );
+            }
+
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(out + w * 64 + part * 32),
+                counts
+            );
+        }
+    }
+
+    for (; w < words; ++w) {
+        count_word_scalar(above, row, below, w, neighbors, out);
+    }
+}
+
+#endif
+
+} // namespace
+
+
+bool neighbor_kernel_supported(NeighborKernel kernel) {
+    switch (kernel) {
+        case NeighborKernel::Scalar:
+            return true;
+
+        case NeighborKernel::Avx2:
+#if defined(AEROSWARM_AVX2_KERNEL)
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+    }
+
+    return false;
+}
+
+
+NeighborKernel default_neighbor_kernel() {
+    static const NeighborKernel kernel =
+        neighbor_kernel_supported(NeighborKernel::Avx2)
+            ? NeighborKernel::Avx2
+            : NeighborKernel::Scalar;
+
+    return kernel;
+}
+
+
+const char* neighbor_kernel_name(NeighborKernel kernel) {
+    switch (kernel) {
+        case NeighborKernel::Scalar:
+            return "scalar";
+        case NeighborKernel::Avx2:
+            return "avx2";
+    }
+
+    return "unknown";
+}
+
+
+void count_open_neighbors(NeighborKernel kernel,
+                          const std::uint64_t* above,
+                          const std::uint64_t* row,
+                          const std::uint64_t* below,
+                          std::size_t words,
+                          std::uint32_t neighbors,
+                          std::uint8_t* out)
+{
+#if defined(AEROSWARM_AVX2_KERNEL)
+    if (kernel == NeighborKernel::Avx2) {
+        count_avx2(above, row, below, words, neighbors, out);
+        return;
+    }
+#else
+    (void)kernel;
+#endif
+
+    count_scalar(above, row, below, words, neighbors, out);
+}
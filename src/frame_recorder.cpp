@@ -0,0 +1,473 @@
+#include "aeroswarm/live/frame_recorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+namespace {
+
+constexpr char stream_magic[4] = {'A', 'S', 'W', 'F'};
+constexpr std::uint32_t stream_version = 1;
+
+constexpr std::uint8_t flag_target_found = 1;
+constexpr std::uint8_t flag_has_target = 2;
+constexpr std::uint8_t flag_has_winner = 4;
+constexpr std::uint8_t flag_visited_reset = 8;
+constexpr std::uint8_t flag_obstacles = 16;
+
+// SdlRenderer's target and drone colors, 0xRRGGBBAA.
+constexpr std::uint32_t target_color = 0xdc3c3cffu;
+constexpr std::uint32_t drone_color = 0x3ca0e6ffu;
+
+
+template <typename Unsigned>
+void write_le(std::ostream& out, Unsigned value) {
+    char bytes[sizeof(Unsigned)];
+
+    for (std::size_t i = 0; i < sizeof(Unsigned); ++i) {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xffu);
+    }
+
+    out.write(bytes, sizeof(bytes));
+}
+
+
+template <typename Unsigned>
+Unsigned read_le(std::istream& in) {
+    unsigned char bytes[sizeof(Unsigned)];
+
+    if (!in.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+        throw std::runtime_error("Truncated frame stream");
+    }
+
+    Unsigned value = 0;
+
+    for (std::size_t i = 0; i < sizeof(Unsigned); ++i) {
+        value |= static_cast<Unsigned>(bytes[i]) << (8 * i);
+    }
+
+    return value;
+}
+
+
+void write_cells(std::ostream& out,
+                 const std::vector<Position>& cells,
+                 int width)
+{
+    write_le(out, static_cast<std::uint32_t>(cells.size()));
+
+    for (const auto& pos : cells) {
+        write_le(
+            out,
+            static_cast<std::uint32_t>(
+                static_cast<std::uint64_t>(pos.y) * width + pos.x
+            )
+        );
+    }
+}
+
+
+std::vector<Position> read_cells(std::istream& in, int width, int height) {
+    const std::uint32_t count = read_le<std::uint32_t>(in);
+
+    const std::uint64_t cell_count =
+        static_cast<std::uint64_t>(width) * height;
+
+    std::vector<Position> cells;
+    cells.reserve(std::min<std::uint64_t>(count, cell_count));
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const std::uint32_t cell = read_le<std::uint32_t>(in);
+
+        if (cell >= cell_count) {
+            throw std::runtime_error("Frame stream cell out of range");
+        }
+
+        cells.push_back({
+            static_cast<int>(cell % static_cast<std::uint32_t>(width)),
+            static_cast<int>(cell / static_cast<std::uint32_t>(width))
+        });
+    }
+
+    return cells;
+}
+
+} // namespace
+
+
+FrameRaster::FrameRaster(int width, int height, int cell_size)
+    : width_(width),
+      height_(height),
+      cell_size_(std::max(1, cell_size)),
+      cells_(width, height),
+      base_(static_cast<std::size_t>(width) * cell_size_ *
+            static_cast<std::size_t>(height) * cell_size_ * 3),
+      tile_(static_cast<std::size_t>(TexelGrid::tile_size) *
+            TexelGrid::tile_size)
+{
+}
+
+
+void FrameRaster::apply(const SimulationSnapshot& frame) {
+    if (frame.visited_epoch_begin == 0) {
+        cells_.clear_visited();
+    }
+
+    for (const auto& pos : frame.visited_cells) {
+        cells_.mark_visited(pos);
+    }
+
+    if (frame.obstacle_positions != obstacles_) {
+        if (frame.obstacle_positions) {
+            cells_.set_obstacles(*frame.obstacle_positions);
+        } else {
+            cells_.set_obstacles({});
+        }
+
+        obstacles_ = frame.obstacle_positions;
+    }
+
+    target_ = frame.target;
+    drones_ = frame.drone_positions;
+}
+
+
+const std::vector<std::uint8_t>& FrameRaster::pixels() {
+    update_base();
+
+    image_ = base_;
+
+    if (target_) {
+        paint(*target_, 0.0f, target_color);
+    }
+
+    for (const auto& pos : drones_) {
+        paint(pos, 0.20f, drone_color);
+    }
+
+    return image_;
+}
+
+
+// Redraws the tiles of the base image whose cells changed.
+void FrameRaster::update_base() {
+    const std::size_t row_bytes =
+        static_cast<std::size_t>(image_width()) * 3;
+
+    cells_.take_dirty_tiles([&](const TexelTile& tile) {
+        cells_.fill(
+            tile,
+            tile_.data(),
+            TexelGrid::tile_size * static_cast<int>(sizeof(std::uint32_t))
+        );
+
+        for (int y = 0; y < tile.height; ++y) {
+            for (int x = 0; x < tile.width; ++x) {
+                const std::uint32_t texel =
+                    tile_[static_cast<std::size_t>(y) * TexelGrid::tile_size + x];
+
+                const std::uint8_t rgb[3] = {
+                    static_cast<std::uint8_t>(texel >> 24),
+                    static_cast<std::uint8_t>(texel >> 16),
+                    static_cast<std::uint8_t>(texel >> 8)
+                };
+
+                const std::size_t left =
+                    static_cast<std::size_t>(tile.x + x) * cell_size_ * 3;
+
+                for (int py = 0; py < cell_size_; ++py) {
+                    std::uint8_t* out =
+                        base_.data() +
+                        (static_cast<std::size_t>(tile.y + y) * cell_size_ + py) *
+                            row_bytes +
+                        left;
+
+                    for (int px = 0; px < cell_size_; ++px) {
+                        out[px * 3 + 0] = rgb[0];
+                        out[px * 3 + 1] = rgb[1];
+                        out[px * 3 + 2] = rgb[2];
+                    }
+                }
+            }
+        }
+    });
+}
+
+
+// Fills a cell, shrunk by `inset` on each side (at least one pixel).
+void FrameRaster::paint(const Position& pos, float inset, std::uint32_t color) {
+    if (pos.x < 0 || pos.y < 0 || pos.x >= width_ || pos.y >= height_) {
+        return;
+    }
+
+    const int margin = std::min(
+        static_cast<int>(std::lround(static_cast<float>(cell_size_) * inset)),
+        (cell_size_ - 1) / 2
+    );
+
+    const std::size_t row_bytes =
+        static_cast<std::size_t>(image_width()) * 3;
+
+    for (int py = margin; py < cell_size_ - margin; ++py) {
+        std::uint8_t* out =
+            image_.data() +
+            (static_cast<std::size_t>(pos.y) * cell_size_ + py) * row_bytes +
+            static_cast<std::size_t>(pos.x) * cell_size_ * 3;
+
+        for (int px = margin; px < cell_size_ - margin; ++px) {
+            out[px * 3 + 0] = static_cast<std::uint8_t>(color >> 24);
+            out[px * 3 + 1] = static_cast<std::uint8_t>(color >> 16);
+            out[px * 3 + 2] = static_cast<std::uint8_t>(color >> 8);
+        }
+    }
+}
+
+
+StreamFrameSink::StreamFrameSink(std::ostream& out, int width, int height)
+    : out_(&out),
+      width_(width)
+{
+    out.write(stream_magic, sizeof(stream_magic));
+    write_le(out, stream_version);
+    write_le(out, static_cast<std::uint32_t>(width));
+    write_le(out, static_cast<std::uint32_t>(height));
+}
+
+
+void StreamFrameSink::write(const SimulationSnapshot& frame, FrameRaster&) {
+    std::ostream& out = *out_;
+
+    const bool new_obstacles =
+        first_frame_ || frame.obstacle_positions != obstacles_;
+
+    std::uint8_t flags = 0;
+
+    if (frame.target_found) {
+        flags |= flag_target_found;
+    }
+
+    if (frame.target) {
+        flags |= flag_has_target;
+    }
+
+    if (frame.winning_drone_id) {
+        flags |= flag_has_winner;
+    }
+
+    if (frame.visited_epoch_begin == 0) {
+        flags |= flag_visited_reset;
+    }
+
+    if (new_obstacles) {
+        flags |= flag_obstacles;
+    }
+
+    write_le(out, static_cast<std::uint64_t>(frame.tick));
+    write_le(out, flags);
+
+    if (frame.target) {
+        write_le(out, static_cast<std::uint32_t>(frame.target->x));
+        write_le(out, static_cast<std::uint32_t>(frame.target->y));
+    }
+
+    if (frame.winning_drone_id) {
+        write_le(out, static_cast<std::uint32_t>(*frame.winning_drone_id));
+        write_le(out, static_cast<std::uint64_t>(frame.winning_tick.value_or(0)));
+    }
+
+    if (new_obstacles) {
+        if (frame.obstacle_positions) {
+            write_cells(out, *frame.obstacle_positions, width_);
+        } else {
+            write_cells(out, {}, width_);
+        }
+
+        obstacles_ = frame.obstacle_positions;
+        first_frame_ = false;
+    }
+
+    write_cells(out, frame.visited_cells, width_);
+    write_cells(out, frame.drone_positions, width_);
+
+    if (!out) {
+        throw std::runtime_error("Frame stream write failed");
+    }
+}
+
+
+void StreamFrameSink::finish() {
+    out_->flush();
+
+    if (!*out_) {
+        throw std::runtime_error("Frame stream write failed");
+    }
+}
+
+
+FrameStreamReader::FrameStreamReader(std::istream& in)
+    : in_(&in)
+{
+    char magic[sizeof(stream_magic)];
+
+    if (!in.read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), stream_magic)) {
+        throw std::runtime_error("Not an AeroSwarm frame stream");
+    }
+
+    if (read_le<std::uint32_t>(in) != stream_version) {
+        throw std::runtime_error("Unsupported frame stream version");
+    }
+
+    width_ = static_cast<int>(read_le<std::uint32_t>(in));
+    height_ = static_cast<int>(read_le<std::uint32_t>(in));
+}
+
+
+bool FrameStreamReader::next(SimulationSnapshot& frame) {
+    std::istream& in = *in_;
+
+    // Clean end of stream: nothing after the last frame.
+    if (in.peek() == std::char_traits<char>::eof()) {
+        return false;
+    }
+
+    frame = SimulationSnapshot{};
+
+    frame.tick = static_cast<std::size_t>(read_le<std::uint64_t>(in));
+
+    const std::uint8_t flags = read_le<std::uint8_t>(in);
+
+    frame.target_found = (flags & flag_target_found) != 0;
+
+    if (flags & flag_has_target) {
+        const auto x = static_cast<std::int32_t>(read_le<std::uint32_t>(in));
+        const auto y = static_cast<std::int32_t>(read_le<std::uint32_t>(in));
+
+        frame.target = Position{x, y};
+    }
+
+    if (flags & flag_has_winner) {
+        frame.winning_drone_id =
+            static_cast<int>(static_cast<std::int32_t>(read_le<std::uint32_t>(in)));
+        frame.winning_tick =
+            static_cast<std::size_t>(read_le<std::uint64_t>(in));
+    }
+
+    if (flags & flag_obstacles) {
+        obstacles_ = std::make_shared<const std::vector<Position>>(
+            read_cells(in, width_, height_)
+        );
+    }
+
+    if (flags & flag_visited_reset) {
+        visited_epoch_ = 0;
+    }
+
+    frame.obstacle_positions = obstacles_;
+    frame.visited_cells = read_cells(in, width_, height_);
+    frame.visited_epoch_begin = visited_epoch_;
+
+    visited_epoch_ += frame.visited_cells.size();
+    frame.visited_epoch = visited_epoch_;
+
+    frame.drone_positions = read_cells(in, width_, height_);
+
+    return true;
+}
+
+
+PpmFrameSink::PpmFrameSink(std::string directory)
+    : directory_(std::move(directory))
+{
+    std::filesystem::create_directories(directory_);
+}
+
+
+void PpmFrameSink::write(const SimulationSnapshot&, FrameRaster& raster) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06zu.ppm", next_frame_++);
+
+    const std::string path =
+        (std::filesystem::path(directory_) / name).string();
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    const auto& pixels = raster.pixels();
+
+    const bool written =
+        std::fprintf(
+            file,
+            "P6\n%d %d\n255\n",
+            raster.image_width(),
+            raster.image_height()
+        ) > 0 &&
+        std::fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+
+    // A full disk often shows only here, when the buffer is flushed.
+    const bool closed = std::fclose(file) == 0;
+
+    if (!written || !closed) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+
+void PipeFrameSink::Closer::operator()(std::FILE* pipe) const {
+    pclose(pipe);
+}
+
+
+PipeFrameSink::PipeFrameSink(const std::string& command) {
+    // An encoder that exits early (not installed, bad arguments) would
+    // otherwise kill the whole process on the next write. Ignored, the
+    // write fails with EPIPE and is reported like any other error.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    pipe_.reset(popen(command.c_str(), "w"));
+
+    if (!pipe_) {
+        throw std::runtime_error("Cannot start encoder: " + command);
+    }
+}
+
+
+void PipeFrameSink::write(const SimulationSnapshot&, FrameRaster& raster) {
+    const auto& pixels = raster.pixels();
+
+    if (std::fwrite(pixels.data(), 1, pixels.size(), pipe_.get()) !=
+        pixels.size()) {
+        throw std::runtime_error("Encoder pipe closed");
+    }
+}
+
+
+void PipeFrameSink::finish() {
+    if (!pipe_) {
+        return;
+    }
+
+    // Frames still in the stdio buffer are only sent here.
+    const bool flushed =
+        std::fflush(pipe_.get()) == 0 && !std::ferror(pipe_.get());
+
+    const int status = pclose(pipe_.release());
+
+    if (!flushed) {
+        throw std::runtime_error("Encoder pipe closed");
+    }
+
+    if (status != 0) {
+        throw std::runtime_error(
+            "Encoder exited with status " + std::to_string(status)
+        );
+    }
+}
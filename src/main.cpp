@@ -1,11 +1,14 @@
+#include <cstdlib>
 #include <iostream>
 #include <string>
 
+#include "aeroswarm/app/batch_runner.hpp"
 #include "aeroswarm/app/sequential_runner.hpp"
 #include "aeroswarm/app/parallel_runner.hpp"
 #include "aeroswarm/app/scenario_validation.hpp"
 #include "aeroswarm/app/parallel_live_runner.hpp"
 #include "aeroswarm/app/parallel_sdl_runner.hpp"
+#include "aeroswarm/app/record_runner.hpp"
 //#include "aeroswarm/app/scenario.hpp"
 #include "aeroswarm/app/scenario_factory.hpp"
 
@@ -15,12 +18,70 @@ int main(int argc, char* argv[]) {
         std::cout
             << "Usage: "
             << argv[0]
-            << " <sequential|parallel|parallel-live|parallel-sdl>\n";
+            << " <sequential|parallel|parallel-live|parallel-sdl>\n"
+            << "       "
+            << argv[0]
+            << " parallel-sdl [map size] [drones]\n"
+            << "       "
+            << argv[0]
+            << " record <stream|ppm|pipe> <file|directory|command>"
+            << " [map size] [drones]\n"
+            << "       "
+            << argv[0]
+            << " batch [seeds per config] [results.csv] [sequential|parallel]"
+            << " [stop|frontier]\n";
         return 1;
     }
 
     const std::string mode = argv[1];
 
+    /*
+    Monte Carlo batch: many random scenarios instead of the single one
+    below, e.g.
+
+        AeroSwarm batch 10000 runs.csv
+        AeroSwarm batch 10000 runs.csv sequential frontier
+
+    30/60/120 maps x 4/16/64 drones, 9% obstacles, seeds 1..N each.
+    `frontier` routes boxed-in drones to unexplored cells (see
+    StuckRecovery) instead of stopping them.
+    */
+    if (mode == "batch") {
+        BatchConfig config;
+        config.map_sizes = {30, 60, 120};
+        config.drone_counts = {4, 16, 64};
+
+        if (argc > 2) {
+            config.seeds_per_config = std::strtoul(argv[2], nullptr, 10);
+        }
+
+        const std::string csv_path = argc > 3 ? argv[3] : "";
+
+        if (argc > 4) {
+            const std::string engine = argv[4];
+
+            if (engine == "parallel") {
+                config.engine = BatchEngine::Parallel;
+            } else if (engine != "sequential") {
+                std::cerr << "Unknown batch engine: " << engine << '\n';
+                return 1;
+            }
+        }
+
+        if (argc > 5) {
+            const std::string recovery = argv[5];
+
+            if (recovery == "frontier") {
+                config.recovery = StuckRecovery::SeekFrontier;
+            } else if (recovery != "stop") {
+                std::cerr << "Unknown stuck recovery: " << recovery << '\n';
+                return 1;
+            }
+        }
+
+        return run_batch_mode(config, csv_path);
+    }
+
 
     Scenario scenario =
         make_random_scenario(
@@ -30,6 +91,42 @@ int main(int argc, char* argv[]) {
             42    // reproducible seed
 
         );
+
+    /*
+    Larger live runs, e.g.
+
+        AeroSwarm parallel-sdl 8192 256
+        AeroSwarm record stream run.aswf 512 64
+
+    size x size map, 9% obstacles. Past ~50 x 50 the SDL monitor draws
+    one texel per cell (see SdlRenderMode).
+    */
+    const int size_arg =
+        mode == "parallel-sdl" ? 2 :
+        mode == "record"       ? 4 :
+                                 0;
+
+    if (size_arg != 0 && argc > size_arg) {
+        const int size = std::atoi(argv[size_arg]);
+
+        const int drone_count =
+            argc > size_arg + 1 ? std::atoi(argv[size_arg + 1]) : 4;
+
+        if (size < 2 || drone_count < 1) {
+            std::cerr << "Invalid map size or drone count\n";
+            return 1;
+        }
+
+        scenario = make_random_scenario(
+            size,
+            size,
+            static_cast<int>(
+                static_cast<long long>(size) * size * 9 / 100
+            ),
+            42,
+            drone_count
+        );
+    }
     std::string error_message;
 
     if (!validate_scenario(scenario, error_message)) {
@@ -56,6 +153,39 @@ int main(int argc, char* argv[]) {
         return run_parallel_sdl(scenario);
     }
 
+    /*
+    Headless recording, no window:
+
+        AeroSwarm record stream run.aswf
+        AeroSwarm record ppm frames
+        AeroSwarm record pipe "ffmpeg -y -f rawvideo -pix_fmt rgb24
+            -s {width}x{height} -r 60 -i - run.mp4"
+    */
+    if (mode == "record") {
+        if (argc < 4) {
+            std::cerr << "record needs a format and an output\n";
+            return 1;
+        }
+
+        RecordConfig config;
+        config.output = argv[3];
+
+        const std::string format = argv[2];
+
+        if (format == "stream") {
+            config.format = RecordFormat::Stream;
+        } else if (format == "ppm") {
+            config.format = RecordFormat::Ppm;
+        } else if (format == "pipe") {
+            config.format = RecordFormat::Pipe;
+        } else {
+            std::cerr << "Unknown record format: " << format << '\n';
+            return 1;
+        }
+
+        return run_record(scenario, config);
+    }
+
     std::cerr << "Unknown mode: " << mode << '\n';
     return 1;
 
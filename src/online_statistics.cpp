@@ -0,0 +1,162 @@
+#include "aeroswarm/app/online_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+void RunningStatistics::add(double value) {
+    if (count_ == 0) {
+        min_ = value;
+        max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    ++count_;
+
+    const double delta = value - mean_;
+    mean_ += delta / static_cast<double>(count_);
+    m2_ += delta * (value - mean_);
+}
+
+std::size_t RunningStatistics::count() const {
+    return count_;
+}
+
+double RunningStatistics::mean() const {
+    return mean_;
+}
+
+double RunningStatistics::stddev() const {
+    if (count_ < 2) {
+        return 0.0;
+    }
+
+    return std::sqrt(m2_ / static_cast<double>(count_ - 1));
+}
+
+double RunningStatistics::min() const {
+    return min_;
+}
+
+double RunningStatistics::max() const {
+    return max_;
+}
+
+
+
+P2Quantile::P2Quantile(double p)
+    : p_(p),
+      desired_{1.0, 1.0 + 2.0 * p, 1.0 + 4.0 * p, 3.0 + 2.0 * p, 5.0},
+      increments_{0.0, p / 2.0, p, (1.0 + p) / 2.0, 1.0}
+{
+    positions_ = {1.0, 2.0, 3.0, 4.0, 5.0};
+}
+
+
+std::size_t P2Quantile::count() const {
+    return count_;
+}
+
+
+void P2Quantile::add(double value) {
+    // Warm-up: the first five values become the initial markers.
+    if (count_ < 5) {
+        heights_[count_] = value;
+        ++count_;
+
+        if (count_ == 5) {
+            std::sort(heights_.begin(), heights_.end());
+        }
+
+        return;
+    }
+
+    ++count_;
+
+    // Cell k such that heights_[k] <= value < heights_[k + 1].
+    std::size_t k = 0;
+
+    if (value < heights_[0]) {
+        heights_[0] = value;
+        k = 0;
+    } else if (value >= heights_[4]) {
+        heights_[4] = value;
+        k = 3;
+    } else {
+        while (value >= heights_[k + 1]) {
+            ++k;
+        }
+    }
+
+    for (std::size_t i = k + 1; i < 5; ++i) {
+        positions_[i] += 1.0;
+    }
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        desired_[i] += increments_[i];
+    }
+
+    // Move the three middle markers towards their desired positions.
+    for (std::size_t i = 1; i <= 3; ++i) {
+        const double d = desired_[i] - positions_[i];
+
+        if ((d >= 1.0 && positions_[i + 1] - positions_[i] > 1.0) ||
+            (d <= -1.0 && positions_[i - 1] - positions_[i] < -1.0)) {
+
+            const int step = d > 0.0 ? 1 : -1;
+            const double candidate = parabolic(i, step);
+
+            if (heights_[i - 1] < candidate && candidate < heights_[i + 1]) {
+                heights_[i] = candidate;
+            } else {
+                heights_[i] = linear(i, step);
+            }
+
+            positions_[i] += step;
+        }
+    }
+}
+
+
+double P2Quantile::parabolic(std::size_t i, double d) const {
+    const double n_prev = positions_[i - 1];
+    const double n = positions_[i];
+    const double n_next = positions_[i + 1];
+
+    return heights_[i] + d / (n_next - n_prev) * (
+        (n - n_prev + d) * (heights_[i + 1] - heights_[i]) / (n_next - n) +
+        (n_next - n - d) * (heights_[i] - heights_[i - 1]) / (n - n_prev)
+    );
+}
+
+
+double P2Quantile::linear(std::size_t i, int d) const {
+    const std::size_t j = d > 0 ? i + 1 : i - 1;
+
+    return heights_[i] +
+        static_cast<double>(d) * (heights_[j] - heights_[i]) /
+        (positions_[j] - positions_[i]);
+}
+
+
+double P2Quantile::value() const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+
+    if (count_ <= 5) {
+        // Exact, over the few stored values (nearest rank).
+        std::array<double, 5> sorted = heights_;
+        std::sort(sorted.begin(), sorted.begin() + count_);
+
+        const auto rank = static_cast<std::size_t>(
+            std::ceil(p_ * static_cast<double>(count_))
+        );
+
+        return sorted[std::max<std::size_t>(rank, 1) - 1];
+    }
+
+    return heights_[2];
+}
@@ -138,9 +138,7 @@ int run_parallel_live(const Scenario& scenario) {
     terrain.set_target(scenario.target);
 
     // Apply the same scenario obstacles used by the other runners.
-    for (const auto& obstacle : scenario.obstacles) {
-        terrain.set_obstacle(obstacle);
-    }
+    terrain.set_obstacles(scenario.obstacles);
 
     /*
     Simulation pacing: 10 ms between worker updates.
@@ -153,11 +151,20 @@ int run_parallel_live(const Scenario& scenario) {
     constexpr auto simulation_interval =
         std::chrono::milliseconds{10};
 
+    /*
+    Snapshots are published by the simulation itself at ~60 Hz into a
+    triple buffer; the frame loop below only picks up the newest one and
+    never waits on a lock held by a drone worker.
+    */
+    ParallelSimulationOptions options;
+    options.update_interval = simulation_interval;
+    options.snapshot_interval = std::chrono::milliseconds{16};
+
     ParallelSimulation simulation{
         terrain,
         scenario.drones,
         scenario.seed,
-        simulation_interval
+        options
     };
 
     /*
@@ -223,15 +230,20 @@ int run_parallel_live(const Scenario& scenario) {
 
     The monitor never directly accesses worker-owned mutable state.
     */
+    // The monitor only prints counts, so it asks for the visited delta
+    // since its previous snapshot instead of the whole list.
+    std::size_t visited_epoch = 0;
+
     while (!simulation_finished.load()) { // read from atomic
 
-        const auto snapshot = simulation.snapshot();
+        const auto snapshot = simulation.latest_snapshot(visited_epoch);
+        visited_epoch = snapshot.visited_epoch;
 
         std::cout
             << "\n"
             << "tick=" << snapshot.tick
             << " drones=" << snapshot.drone_positions.size()
-            << " visited=" << snapshot.visited_cells.size()
+            << " visited=" << snapshot.visited_epoch
             << " target_found="
             << (snapshot.target_found ? "true" : "false")
             << std::flush;
@@ -250,7 +262,7 @@ int run_parallel_live(const Scenario& scenario) {
     simulation_thread.join();
 
     // Capture the final stable state after all workers have finished.
-    const auto snapshot = simulation.snapshot();
+    const auto snapshot = simulation.latest_snapshot(visited_epoch);
 
     std::cout
         << '\n'
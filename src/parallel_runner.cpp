@@ -13,14 +13,18 @@ int run_parallel(const Scenario& scenario) {
     };
 
     terrain.set_target(scenario.target);
-    for (const auto& obstacle : scenario.obstacles) {
-        terrain.set_obstacle(obstacle);
-    }
+    terrain.set_obstacles(scenario.obstacles);
+
+    // Headless: as fast as possible, on a fixed pool of threads rather
+    // than one thread per drone.
+    ParallelSimulationOptions options;
+    options.execution = ParallelExecution::ThreadPool;
 
     ParallelSimulation simulation{
         terrain,
         scenario.drones,
-        scenario.seed
+        scenario.seed,
+        options
     };
 
     const auto status = simulation.run();
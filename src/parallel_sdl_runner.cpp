@@ -1,5 +1,6 @@
 #include "aeroswarm/app/parallel_sdl_runner.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <iostream>
@@ -8,6 +9,7 @@
 #include "aeroswarm/live/sdl_renderer.hpp"
 #include "aeroswarm/parallel/simulation.hpp"
 #include "aeroswarm/parallel/terrain.hpp"
+#include "aeroswarm/stop_token.hpp"
 
 /*
 SDL live mode
@@ -63,9 +65,7 @@ int run_parallel_sdl(const Scenario& scenario) {
 
     terrain.set_target(scenario.target);
 
-    for (const auto& obstacle : scenario.obstacles) {
-        terrain.set_obstacle(obstacle);
-    }
+    terrain.set_obstacles(scenario.obstacles);
 
     /*
     Worker update cadence:
@@ -78,11 +78,20 @@ int run_parallel_sdl(const Scenario& scenario) {
     constexpr auto simulation_interval =
         std::chrono::milliseconds{10};
 
+    /*
+    Snapshots are published by the simulation itself at ~60 Hz into a
+    triple buffer; the frame loop below only picks up the newest one and
+    never waits on a lock held by a drone worker.
+    */
+    ParallelSimulationOptions options;
+    options.update_interval = simulation_interval;
+    options.snapshot_interval = std::chrono::milliseconds{16};
+
     ParallelSimulation simulation{
         terrain,
         scenario.drones,
         scenario.seed,
-        simulation_interval
+        options
     };
 
     /*
@@ -96,10 +105,24 @@ int run_parallel_sdl(const Scenario& scenario) {
     SDL documents window creation and event polling as main-thread
     operations. 
     */
+    /*
+    Maps that fit the screen at 20 px per cell are drawn cell by cell,
+    with grid lines; larger ones as one texel per cell, scaled down
+    (see SdlRenderMode).
+    */
+    constexpr int cell_size = 20;
+
+    const SdlRenderMode render_mode =
+        std::max(scenario.width, scenario.height) * cell_size <=
+                SdlRenderer::max_texel_map_pixels
+            ? SdlRenderMode::Cells
+            : SdlRenderMode::Texels;
+
     SdlRenderer renderer{
         scenario.width,
         scenario.height,
-        20
+        cell_size,
+        render_mode
     };
 
     /*
@@ -123,8 +146,11 @@ int run_parallel_sdl(const Scenario& scenario) {
     completed. The thread then publishes completion through the atomic
     flag.
     */
+    // Closing the window stops the workers instead of waiting for them.
+    StopSource stop_source;
+
     std::thread simulation_thread([&]() {
-        final_status = simulation.run();
+        final_status = simulation.run(stop_source.get_token());
         simulation_finished.store(true);
     });
 
@@ -166,7 +192,9 @@ int run_parallel_sdl(const Scenario& scenario) {
 
         // While running: latest live state.
         // After finishing: final frozen state.
-        const auto snapshot = simulation.snapshot();
+        // Only the visited cells the renderer has not seen yet.
+        const auto snapshot =
+            simulation.latest_snapshot(renderer.visited_epoch());
 
         renderer.render(snapshot);
 
@@ -179,19 +207,20 @@ int run_parallel_sdl(const Scenario& scenario) {
     very soon.
 
     If the user closes the SDL window BEFORE the simulation finishes,
-    this current design still waits for the simulation to finish.
-
-    Later we can add a cancellation/stop request.
+    the stop request makes every worker return after its current move
+    (at most one update interval), and run() reports Cancelled.
     */
     /*
     If the user closed the window while the simulation was still running,
     we still need to join the simulation thread before destroying simulation.
     */
     if (!simulation_joined) {
+        stop_source.request_stop();
         simulation_thread.join();
     }
 
-    const auto final_snapshot = simulation.snapshot();
+    const auto final_snapshot =
+        simulation.snapshot(renderer.visited_epoch());
 
     if (final_status == ParallelSimulationStatus::TargetFound) {
         std::cout << "Parallel SDL simulation: target found\n";
@@ -202,6 +231,8 @@ int run_parallel_sdl(const Scenario& scenario) {
                 << final_snapshot.winning_drone_id.value()
                 << '\n';
         }
+    } else if (final_status == ParallelSimulationStatus::Cancelled) {
+        std::cout << "Parallel SDL simulation: cancelled\n";
     } else {
         std::cout << "Parallel SDL simulation: stuck\n";
     }
@@ -211,6 +242,19 @@ int run_parallel_sdl(const Scenario& scenario) {
         << final_snapshot.tick
         << '\n';
 
+    // Render cost at the final map coverage.
+    const RenderStats& render_stats = renderer.stats();
+
+    std::cout
+        << "Rendered frames: "
+        << render_stats.frames
+        << ", mean render time: "
+        << render_stats.mean_frame_ms()
+        << " ms, draw calls per frame: "
+        << render_stats.draw_calls
+        << " (" << render_stats.visited_cells
+        << " visited cells)\n";
+
 
    // Allocation instrumentation summary
     //  include/aeroswarm/parallel/terrain.hpp
@@ -1,5 +1,9 @@
 #include <utility>
 #include "aeroswarm/parallel/simulation.hpp"
+#include "aeroswarm/parallel/barrier.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <random>
 #include <stdexcept>
 
@@ -8,26 +12,126 @@ ParallelSimulation::ParallelSimulation(
                 std::vector<Drone> drones,
                 unsigned int seed,
                 std::chrono::milliseconds update_interval)
+                : ParallelSimulation(
+                    terrain,
+                    std::move(drones),
+                    seed,
+                    ParallelSimulationOptions{update_interval, {}})
+            {
+            }
+
+
+ParallelSimulation::ParallelSimulation(
+                ParallelTerrain& terrain,
+                std::vector<Drone> drones,
+                unsigned int seed,
+                ParallelSimulationOptions options)
                 : terrain_(terrain),
-                drones_(std::move(drones)),
+                positions_(std::make_unique<DronePosition[]>(drones.size())),
                 seed_(seed),
-                update_interval_(update_interval)
+                update_interval_(options.update_interval),
+                execution_(options.execution),
+                worker_threads_(options.worker_threads),
+                recovery_(options.recovery),
+                snapshot_interval_(options.snapshot_interval)
             {
-                for (const auto& drone : drones_) {
+                drone_ids_.reserve(drones.size());
+
+                for (const auto& drone : drones) {
                     if (!terrain_.initialize_start_position(drone.position())) {
                         throw std::invalid_argument("Invalid drone start position");
                     }
+
+                    store_position(drone_ids_.size(), drone.position());
+                    drone_ids_.push_back(drone.id());
+                }
+
+                // A consumer that starts before run() still gets a frame.
+                if (snapshot_interval_.count() > 0) {
+                    publish_snapshot();
                 }
             }
 
 
+namespace {
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "the winner slot must never fall back to a lock");
+
+constexpr std::uint64_t winner_valid_bit = std::uint64_t{1} << 63;
+constexpr std::uint64_t winner_tick_max = (std::uint64_t{1} << 31) - 1;
+
+
+std::size_t winner_tick(std::uint64_t winner) {
+    return static_cast<std::size_t>((winner >> 32) & winner_tick_max);
+}
+
+}
+
+
+bool ParallelSimulation::try_record_winner(int drone_id, std::size_t tick) {
+    const std::uint64_t encoded =
+        winner_valid_bit |
+        (std::min<std::uint64_t>(tick, winner_tick_max) << 32) |
+        static_cast<std::uint32_t>(drone_id);
+
+    // Only an empty slot can be taken: the first winner stays.
+    std::uint64_t expected = 0;
+    return winner_.compare_exchange_strong(expected, encoded);
+}
+
+
+bool ParallelSimulation::keep_running() {
+    if (target_found()) {
+        return false;
+    }
+
+    if (stop_reason_.load(std::memory_order_relaxed) != StopReason::None) {
+        return false;
+    }
+
+    StopReason reason = StopReason::None;
+
+    if (stop_token_.stop_requested()) {
+        reason = StopReason::Cancelled;
+    } else if (deadline_.has_value() &&
+               std::chrono::steady_clock::now() >= deadline_.value()) {
+        reason = StopReason::DeadlineExceeded;
+    } else {
+        return true;
+    }
+
+    // First reason noticed wins.
+    StopReason expected = StopReason::None;
+    stop_reason_.compare_exchange_strong(expected, reason);
+
+    return false;
+}
+
+
 bool ParallelSimulation::target_found() const {
-    return target_found_.load();
+    return (winner_.load() & winner_valid_bit) != 0;
+
+}
+std::optional<std::size_t> ParallelSimulation::winning_tick() const {
+    const std::uint64_t winner = winner_.load();
 
+    if ((winner & winner_valid_bit) == 0) {
+        return std::nullopt;
+    }
+
+    return winner_tick(winner);
 }
+
+
 std::optional<int> ParallelSimulation::winning_drone_id() const {
-    std::lock_guard<std::mutex> lock(winner_mutex_);
-    return winning_drone_id_;
+    const std::uint64_t winner = winner_.load();
+
+    if ((winner & winner_valid_bit) == 0) {
+        return std::nullopt;
+    }
+
+    return static_cast<int>(static_cast<std::uint32_t>(winner));
 }
 
 
@@ -47,219 +151,857 @@ Worker 3 ──┘
     >>>> our different pieces of shared state <<<<
 
             Terrain/grid
-                protected by ParallelTerrain::mtx_
+                ParallelTerrain's SelectableLock policy, picked by
+                TerrainSynchronization when the terrain is built:
+                one mutex (GlobalMutex), the tiles around a cell
+                (Tiled), or atomic cells and no lock (LockFree);
+                obstacle list and target under static_mtx_, which
+                drone workers never take
 
-            Drone positions (shared_mutex:: shared_mutex because we 
-                            have two kinds of access :: read/write)
-                protected by ParallelSimulation::drones_mutex_
+            Drone positions
+                one atomic 64-bit slot per drone, one cache line each
 
+                    worker #1          worker #2          snapshot()
+                    store slot 1       store slot 2       load all slots
+                        |                  |              (seqlock retry)
+                        no lock, nobody waits for anybody
 
-                                  drones_mutex_
 
-                    snapshot()       worker #2 read
-                    shared_lock      shared_lock
-                        \              /
-                        \            /
-                            both allowed
 
-                                BUT
 
-                            worker moves drone
-                            unique_lock
-                                |
-                        everyone else waits
 
 
 
+            Winner (found flag + drone id + tick of the win)
+                one atomic word, set once by compare-exchange
 
+            tick
+                atomic
 
+*/
 
+Position ParallelSimulation::load_position(std::size_t drone_index) const {
+    const std::uint64_t packed =
+        positions_[drone_index].packed.load(std::memory_order_relaxed);
 
-            Winner ID
-                protected by ParallelSimulation::winner_mutex_
+    return Position{
+        static_cast<int>(static_cast<std::uint32_t>(packed)),
+        static_cast<int>(static_cast<std::uint32_t>(packed >> 32))
+    };
+}
 
-            target_found + tick
-                atomic
 
-*/
+void ParallelSimulation::store_position(std::size_t drone_index,
+                                        const Position& pos)
+{
+    const std::uint64_t packed =
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.x)) |
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.y))
+            << 32);
 
-void ParallelSimulation::worker(std::size_t drone_index) {
+    positions_[drone_index].packed.store(packed, std::memory_order_relaxed);
+}
 
-    std::mt19937 rng(
-        seed_ + static_cast<unsigned int>(drone_index)
-    );
 
+namespace {
+
+// Optimistic attempts before a snapshot reader asks workers to pause.
+constexpr int optimistic_collects = 8;
+
+}
+
+
+void ParallelSimulation::collect_positions(std::vector<Position>& out) const {
+    bool paused = false;
+
+    for (int attempt = 0; ; ++attempt) {
+        if (attempt == optimistic_collects) {
+            pending_readers_.fetch_add(1);
+            paused = true;
+        }
+
+        const std::size_t done =
+            position_writes_done_.load(std::memory_order_acquire);
+
+        out.clear();
+        out.reserve(drone_ids_.size());
+
+        for (std::size_t i = 0; i < drone_ids_.size(); ++i) {
+            out.push_back(load_position(i));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
 
+        const std::size_t begun =
+            position_writes_begun_.load(std::memory_order_relaxed);
 
-    int drone_id;
+        // No move started since `done` was read: the copy is one
+        // state the swarm was actually in.
+        if (begun == done) {
+            break;
+        }
+    }
 
-    {
-        std::shared_lock<std::shared_mutex> lock(drones_mutex_);
-        drone_id = drones_[drone_index].id();
+    if (paused) {
+        pending_readers_.fetch_sub(1);
     }
+}
+
 
+std::optional<ParallelSimulation::MoveChoice>
+ParallelSimulation::choose_move(std::size_t drone_index, DroneRng& rng) const
+{
+    // Only this thread writes this drone's slot.
+    const Position current_position = load_position(drone_index);
+
+    // One terrain query (one lock) per move: candidates together
+    // with their target flag and information gain.
+    const auto neighbors =
+        terrain_.scored_neighbors(current_position);
+
+    if (neighbors.empty()) {
+        return std::nullopt;
+    }
+
+    // If the target is directly reachable, prioritize it immediately.
+    std::optional<Position> target_candidate;
+
+    for (const auto& candidate : neighbors) {
+        if (candidate.is_target) {
+            target_candidate = candidate.position;
+            break;
+        }
+    }
+
+    Position next;
+
+    if (target_candidate.has_value()) {
+        next = target_candidate.value();
+    } else {
+        int best_gain = -1;
+
+        // At most 8 ties: fixed capacity, no per-move allocation.
+        Neighbors best_candidates;
+
+        for (const auto& candidate : neighbors) {
+            const int gain = candidate.information_gain;
+
+            if (gain > best_gain) {
+                best_gain = gain;
+                best_candidates.count = 0;
+            }
+
+            if (gain == best_gain) {
+                best_candidates[best_candidates.count] =
+                    candidate.position;
+                ++best_candidates.count;
+            }
+        }
+
+        std::uniform_int_distribution<std::size_t> dist(
+            0,
+            best_candidates.size() - 1
+        );
+
+        next = best_candidates[dist(rng)];
+    }
+
+    return MoveChoice{next, target_candidate.has_value()};
+}
+
+
+std::optional<ParallelSimulation::MoveChoice>
+ParallelSimulation::plan_move(std::size_t drone_index,
+                              DroneRng& rng,
+                              FrontierRoute& route,
+                              FrontierSearch& search) const
+{
+    if (route.active()) {
+        // Visited cells stay visited, so the cells before the frontier
+        // are still passable; only the frontier itself can be lost.
+        if (!terrain_.cell_at(route.frontier()).visited) {
+            return route_move(route);
+        }
+
+        route.clear();
+    }
+
+    auto choice = choose_move(drone_index, rng);
+
+    if (choice.has_value() || recovery_ != StuckRecovery::SeekFrontier) {
+        return choice;
+    }
+
+    if (!search.find_route(terrain_, load_position(drone_index), route)) {
+        return std::nullopt;
+    }
+
+    return route_move(route);
+}
+
+
+ParallelSimulation::MoveChoice
+ParallelSimulation::route_move(const FrontierRoute& route) const
+{
+    const Position& next = route.cells[route.next];
+
+    if (!route.at_frontier()) {
+        return MoveChoice{next, false, false, true};
+    }
+
+    return MoveChoice{next, terrain_.is_target(next), true, true};
+}
+
+
+ParallelSimulation::DroneStep ParallelSimulation::commit_move(
+    std::size_t drone_index,
+    const MoveChoice& choice,
+    std::size_t tick)
+{
+    const Position& next = choice.next;
+
+    // A snapshot reader that keeps losing the seqlock race gets a gap.
+    while (pending_readers_.load(std::memory_order_relaxed) > 0) {
+        std::this_thread::yield();
+    }
+
+    position_writes_begun_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    store_position(drone_index, next);
+
+    position_writes_done_.fetch_add(1, std::memory_order_release);
+
+    // The target layer never changes during a run, so the flag from
+    // scored_neighbors() is still valid: no extra is_target() lock.
+    if (choice.is_target) {
+        try_record_winner(drone_ids_[drone_index], tick);
+        return DroneStep::ReachedTarget;
+    }
+
+    return DroneStep::Moved;
+}
+
+
+ParallelSimulation::DroneStep ParallelSimulation::step_drone(
+    std::size_t drone_index,
+    DroneRng& rng,
+    FrontierRoute& route,
+    FrontierSearch& search)
+{
+    const auto choice = plan_move(drone_index, rng, route, search);
+
+    if (!choice.has_value()) {
+        return DroneStep::Stuck;
+    }
+
+    // Another drone may have claimed it since scored_neighbors() (or
+    // since the route was planned: plan a new one next time).
+    if (choice->claim && !terrain_.try_claim_cell(choice->next)) {
+        if (choice->from_route) {
+            route.clear();
+        }
+
+        return DroneStep::Blocked;
+    }
+
+    if (choice->from_route) {
+        ++route.next;
+    }
+
+    const std::size_t tick = tick_.fetch_add(1) + 1;
+
+    return commit_move(drone_index, choice.value(), tick);
+}
+
+
+void ParallelSimulation::worker(std::size_t drone_index) {
+
+    DroneRng rng(
+        seed_ + static_cast<unsigned int>(drone_index)
+    );
+
+    FrontierRoute route;
+    FrontierSearch search;
 
     auto next_update = std::chrono::steady_clock::now();
-    while (!target_found_.load()) {
+    while (keep_running()) {
 
         if (update_interval_.count() > 0) {
             next_update += update_interval_;
             std::this_thread::sleep_until(next_update);
         }
 
-        Position current_position;
+        const DroneStep step = step_drone(drone_index, rng, route, search);
 
-        // READ drone state safely
-        {
-            //I only want to read. Other readers may read at the same time.
-            std::shared_lock<std::shared_mutex> lock(drones_mutex_);
-            current_position = drones_[drone_index].position();
+        if (step == DroneStep::Stuck ||
+            step == DroneStep::ReachedTarget) {
+            return;
         }
+    }
+}
 
-        // Terrain has its own mutex internally
-        const auto neighbors =
-            terrain_.available_neighbors(current_position);
 
-        if (neighbors.empty()) {
-            return;
-        }
 
-        // std::uniform_int_distribution<std::size_t> dist(
-        //     0,
-        //     neighbors.size() - 1
-        // );
+/*
+ThreadPool execution
+
+    drones 0..N-1 dealt round-robin over the queues
+
+    pool thread t:
+        pop a drone from queue t   (or steal one from another queue)
+        step it (a few moves, or one paced move)
+        still active?  push it back to queue t
+        stuck?         drop it: active_drones - 1
+
+A thread never stays bound to a drone, so stuck drones simply leave the
+queues and their thread keeps stepping the remaining ones (or steals
+them from busier threads). A thread with nothing to pop or steal
+sleeps until a drone is pushed back; near the end of a run, when fewer
+drones than threads are left, the extra threads cost no CPU. The pool
+ends when the target is found or no active drone is left: the first
+thread to leave closes the queues and wakes the sleepers.
+
+Paced runs: a thread sleeps until its popped drone is due while still
+holding it, so the drones behind it in the same queue wait too. Each
+queue cycles round-robin and every drone has the same interval, so the
+front drone is normally the next one due and the others are not
+delayed; only a stolen drone, appended out of turn, can start up to one
+interval late on its new thread.
+
+DroneTask (engine + pacing deadline) is only touched by the thread that
+currently holds the drone index; the queue mutexes order the hand-over
+between threads.
+*/
+
+namespace {
 
-        // const Position next = neighbors[dist(rng)];
+// Moves per task pick-up when unpaced: amortizes the queue locks.
+constexpr int pool_steps_per_task = 32;
 
+}
 
-        // If the target is directly reachable, prioritize it immediately.
-        std::optional<Position> target_candidate;
 
-        for (const auto& candidate : neighbors) {
-            if (terrain_.is_target(candidate)) {
-                target_candidate = candidate;
+void ParallelSimulation::pool_worker(
+    std::size_t thread_index,
+    WorkStealingQueues& queues,
+    std::vector<DroneTask>& tasks,
+    std::atomic<std::size_t>& active_drones)
+{
+    // Only used by boxed-in drones (SeekFrontier), sized on first use.
+    FrontierSearch search;
+
+    while (keep_running() && active_drones.load() > 0) {
+
+        auto drone_index = queues.pop(thread_index);
+
+        if (!drone_index.has_value()) {
+            drone_index = queues.steal(thread_index);
+        }
+
+        if (!drone_index.has_value()) {
+            // Every remaining drone is being stepped by another thread.
+            if (!queues.wait_for_task()) {
                 break;
             }
+
+            continue;
         }
 
-        Position next;
+        DroneTask& task = tasks[drone_index.value()];
 
-        if (target_candidate.has_value()) {
-            next = target_candidate.value();
-        } else {
-            int best_gain = -1;
-            std::vector<Position> best_candidates;
-
-            for (const auto& candidate : neighbors) {
-                const int gain = terrain_.information_gain(candidate);
-
-                if (gain > best_gain) {
-                    best_gain = gain;
-                    best_candidates.clear();
-                    best_candidates.push_back(candidate);
-                } else if (gain == best_gain) {
-                    best_candidates.push_back(candidate);
-                }
-            }
+        bool active = true;
+        int steps = pool_steps_per_task;
+
+        if (update_interval_.count() > 0) {
+            // Queues cycle round-robin, so the popped drone is (close
+            // to) the next one due.
+            std::this_thread::sleep_until(task.next_update);
+            task.next_update += update_interval_;
+            steps = 1;
+        }
 
-            std::uniform_int_distribution<std::size_t> dist(
-                0,
-                best_candidates.size() - 1
+        for (int i = 0; i < steps && keep_running(); ++i) {
+            const DroneStep step = step_drone(
+                drone_index.value(),
+                task.rng,
+                task.route,
+                search
             );
 
-            next = best_candidates[dist(rng)];
+            if (step == DroneStep::Stuck ||
+                step == DroneStep::ReachedTarget) {
+                active = false;
+                break;
+            }
         }
 
-        // Another drone may have claimed it since available_neighbors()
-        if (!terrain_.try_claim_cell(next)) {
-            continue;
+        if (active) {
+            queues.push(thread_index, drone_index.value());
+        } else {
+            active_drones.fetch_sub(1);
         }
+    }
 
-        // WRITE drone state safely
-        {
-            // in share_mute, when we write we use unique_lock
-            // I am writing. Nobody else may read or write this protected state while I do it.
-            std::unique_lock<std::shared_mutex> lock(drones_mutex_);
-            drones_[drone_index].move_to(next);
-        }
+    // Target found, stopped, or the last drone is done: nothing will be
+    // pushed any more.
+    queues.close();
+}
+
+
+std::size_t ParallelSimulation::pool_threads() const {
+    std::size_t thread_count = worker_threads_;
+
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+
+    return std::max<std::size_t>(
+        1,
+        std::min(thread_count, drone_ids_.size())
+    );
+}
+
+
+void ParallelSimulation::run_pool() {
+    const std::size_t thread_count = pool_threads();
+
+    WorkStealingQueues queues{thread_count};
+    std::vector<DroneTask> tasks;
+    tasks.reserve(drone_ids_.size());
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < drone_ids_.size(); ++i) {
+        tasks.push_back(DroneTask{
+            DroneRng(seed_ + static_cast<unsigned int>(i)),
+            start + update_interval_,
+            FrontierRoute{}
+        });
+
+        queues.push(i % thread_count, i);
+    }
+
+    std::atomic<std::size_t> active_drones{drone_ids_.size()};
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back(
+            &ParallelSimulation::pool_worker,
+            this,
+            t,
+            std::ref(queues),
+            std::ref(tasks),
+            std::ref(active_drones)
+        );
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+
+/*
+Lockstep execution
+
+Every round (= one tick) runs in two phases, separated by barriers:
+
+    choose     every active drone picks its move from the terrain as
+               it was at the end of the previous round (nobody writes
+               the terrain in this phase) and bids for the cell:
+
+                   owner[cell] = max(owner[cell], bid)
+
+    ── barrier ──
+
+    commit     the drone whose bid is still in owner[cell] claims the
+               cell and moves; all other bidders stay where they are
+
+    ── barrier ── (last thread: tick + 1, stop check, pacing)
+
+A bid packs the round and the drone's rank for that round:
+
+    bits 63..32   round + 1      (stale bids from older rounds lose)
+    bits 31..0    ~rank          (lower rank wins)
 
+    rank = (drone_index + round + seed) % drone_count
+
+so the slots never need resetting, ties are impossible and the
+priority rotates every round.
+
+A drone flying a frontier route (StuckRecovery::SeekFrontier) over
+already visited cells does not bid: nothing is claimed, and several
+drones may share such a cell. Only the route's last cell is bid for.
+
+Drones are split into fixed contiguous slices, one per thread, and
+each drone has its own engine. Every decision therefore depends only
+on the previous round's terrain and the drone's own engine: drone
+positions, visited cells, winner and tick are identical for any
+worker_threads. (Only the order of entries in the visited journal
+within one round depends on thread timing.)
+*/
+
+namespace {
+
+std::uint64_t lockstep_bid(std::size_t drone_index,
+                           std::uint32_t round,
+                           unsigned int seed,
+                           std::size_t drone_count)
+{
+    const std::uint64_t rank =
+        (static_cast<std::uint64_t>(drone_index) + round + seed) %
+        drone_count;
+
+    return ((static_cast<std::uint64_t>(round) + 1) << 32) |
+           (0xFFFFFFFFull - rank);
+}
+
+
+void raise_bid(std::atomic<std::uint64_t>& slot, std::uint64_t bid) {
+    std::uint64_t current = slot.load(std::memory_order_relaxed);
+
+    while (current < bid &&
+           !slot.compare_exchange_weak(current, bid,
+                                       std::memory_order_relaxed)) {
+    }
+}
+
+}
+
+
+void ParallelSimulation::run_lockstep() {
+    const std::size_t drone_count = drone_ids_.size();
+
+    if (drone_count == 0) {
+        return;
+    }
+
+    const std::size_t thread_count = pool_threads();
+
+    std::vector<DroneRng> engines;
+    engines.reserve(drone_count);
+
+    for (std::size_t i = 0; i < drone_count; ++i) {
+        engines.emplace_back(seed_ + static_cast<unsigned int>(i));
+    }
+
+    // Per-drone state, each entry only touched by the owning slice.
+    std::vector<std::optional<MoveChoice>> choices(drone_count);
+    std::vector<std::uint8_t> active(drone_count, 1);
+    std::vector<FrontierRoute> routes(drone_count);
+
+    const auto owners =
+        std::make_unique<std::atomic<std::uint64_t>[]>(
+            terrain_.cell_count()
+        );
+
+    const auto cell_of = [this](const Position& pos) {
+        return static_cast<std::size_t>(pos.y) *
+               static_cast<std::size_t>(terrain_.width()) +
+               static_cast<std::size_t>(pos.x);
+    };
+
+    std::atomic<std::size_t> active_drones{drone_count};
+
+    // Written only by the barrier completion, read between barriers.
+    std::uint32_t round = 0;
+    bool done = false;
+    auto next_round = std::chrono::steady_clock::now();
+
+    Barrier chosen{thread_count};
+
+    Barrier committed{thread_count, [&]() {
         tick_.fetch_add(1);
+        ++round;
+
+        done = !keep_running() || active_drones.load() == 0;
+
+        if (!done && update_interval_.count() > 0) {
+            next_round += update_interval_;
+            std::this_thread::sleep_until(next_round);
+        }
+    }};
+
+    const auto slice = [&](std::size_t t) {
+        const std::size_t begin = drone_count * t / thread_count;
+        const std::size_t end = drone_count * (t + 1) / thread_count;
+
+        FrontierSearch search;
+
+        while (true) {
+            for (std::size_t i = begin; i < end; ++i) {
+                choices[i].reset();
+
+                if (!active[i]) {
+                    continue;
+                }
+
+                choices[i] = plan_move(i, engines[i], routes[i], search);
+
+                if (!choices[i].has_value()) {
+                    active[i] = 0;
+                    active_drones.fetch_sub(1);
+                    continue;
+                }
 
-        if (terrain_.is_target(next)) {
+                // Flying over a visited cell: no claim, no bid.
+                if (!choices[i]->claim) {
+                    continue;
+                }
+
+                raise_bid(
+                    owners[cell_of(choices[i]->next)],
+                    lockstep_bid(i, round, seed_, drone_count)
+                );
+            }
+
+            chosen.arrive_and_wait();
+
+            for (std::size_t i = begin; i < end; ++i) {
+                if (!choices[i].has_value()) {
+                    continue;
+                }
 
-            std::lock_guard<std::mutex> lock(winner_mutex_);
+                if (choices[i]->claim) {
+                    const std::uint64_t winner =
+                        owners[cell_of(choices[i]->next)].load(
+                            std::memory_order_relaxed
+                        );
+
+                    if (winner != lockstep_bid(i, round, seed_, drone_count)) {
+                        continue;
+                    }
+
+                    if (!terrain_.try_claim_cell(choices[i]->next)) {
+                        continue;
+                    }
+                }
 
-            if (!winning_drone_id_.has_value()) {
-                winning_drone_id_ = drone_id;
-                target_found_.store(true);
+                if (choices[i]->from_route) {
+                    ++routes[i].next;
+                }
+
+                if (commit_move(i, choices[i].value(), round + 1) ==
+                        DroneStep::ReachedTarget) {
+                    active[i] = 0;
+                }
             }
 
-            return;
+            committed.arrive_and_wait();
+
+            if (done) {
+                return;
+            }
         }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back(slice, t);
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
     }
 }
 
 
-SimulationSnapshot ParallelSimulation::snapshot() const {
+
+SimulationSnapshot ParallelSimulation::snapshot(
+    std::size_t visited_epoch) const
+{
     SimulationSnapshot snapshot;
+    fill_snapshot(snapshot, visited_epoch);
+    return snapshot;
+}
 
-    snapshot.target_found = target_found_.load();
+
+void ParallelSimulation::fill_snapshot(
+    SimulationSnapshot& snapshot,
+    std::size_t visited_epoch) const
+{
     snapshot.tick = tick_.load();
 
-    {
-        std::lock_guard<std::mutex> lock(winner_mutex_);
-        snapshot.winning_drone_id = winning_drone_id_;
+    // One load: found flag, winner and its tick always agree.
+    const std::uint64_t winner = winner_.load();
+
+    snapshot.target_found = (winner & winner_valid_bit) != 0;
+    snapshot.winning_drone_id = std::nullopt;
+    snapshot.winning_tick = std::nullopt;
+
+    if (snapshot.target_found) {
+        snapshot.winning_drone_id =
+            static_cast<int>(static_cast<std::uint32_t>(winner));
+        snapshot.winning_tick = winner_tick(winner);
     }
 
 
-    // renderer’s snapshot also only reads:
-    {
-        std::shared_lock<std::shared_mutex> lock(drones_mutex_);
+    // renderer’s snapshot also only reads, without blocking anyone:
+    collect_positions(snapshot.drone_positions);
 
-        snapshot.drone_positions.reserve(drones_.size());
+    // Only the cells visited since the consumer's last snapshot; the
+    // journal read takes no terrain lock.
+    snapshot.visited_cells.clear();
+    snapshot.visited_epoch_begin = visited_epoch;
+    snapshot.visited_epoch =
+        terrain_.visited_since(visited_epoch, snapshot.visited_cells);
 
-        for (const auto& drone : drones_) {
-            snapshot.drone_positions.push_back(
-                drone.position()
-            );
+    snapshot.obstacle_positions = terrain_.shared_obstacle_positions();
+
+    snapshot.target = terrain_.target_position();
+}
+
+
+
+/*
+Snapshot publication
+
+    publisher thread                         consumer (renderer)
+    every snapshot_interval:                 every frame:
+
+      fill write_buffer()                      update()
+        drones, tick, winner,                  copy read_buffer()
+        visited_epoch = journal size           + visited_since(epoch,
+      publish()                                    ..., frame epoch)
+
+The frame itself carries no visited cells: each consumer wants a
+different delta, and the journal already serves any delta lock-free.
+The frame's visited_epoch caps the delta so cells and drones stay
+consistent with each other.
+*/
+
+void ParallelSimulation::publish_snapshot() {
+    auto& frame = frames_.write_buffer();
+
+    // Empty delta: visited_epoch only records the journal size.
+    fill_snapshot(frame, terrain_.visited_count());
+
+    frames_.publish();
+}
+
+
+void ParallelSimulation::publisher() {
+    auto next_publish = std::chrono::steady_clock::now();
+
+    while (true) {
+        next_publish += snapshot_interval_;
+
+        {
+            std::unique_lock<std::mutex> lock(publisher_mutex_);
+
+            if (publisher_wakeup_.wait_until(
+                    lock,
+                    next_publish,
+                    [this]() { return workers_done_; })) {
+                break;
+            }
         }
+
+        publish_snapshot();
     }
 
-    snapshot.visited_cells = terrain_.visited_positions();
+    // Final state, after every worker has returned.
+    publish_snapshot();
+}
 
-    snapshot.obstacle_positions = terrain_.obstacle_positions();
 
-    snapshot.target = terrain_.target_position();
+SimulationSnapshot ParallelSimulation::latest_snapshot(
+    std::size_t visited_epoch) const
+{
+    if (snapshot_interval_.count() <= 0) {
+        return snapshot(visited_epoch);
+    }
+
+    std::lock_guard<std::mutex> lock(consumer_mutex_);
+
+    frames_.update();
+
+    SimulationSnapshot snapshot = frames_.read_buffer();
+
+    snapshot.visited_epoch_begin = visited_epoch;
+    snapshot.visited_epoch = terrain_.visited_since(
+        visited_epoch,
+        snapshot.visited_cells,
+        snapshot.visited_epoch
+    );
 
     return snapshot;
 }
 
 
 
-ParallelSimulationStatus ParallelSimulation::run() {
-    std::vector<std::thread> threads;
-    /*
-    
-    Thread 0 -> this->worker(0)
-    Thread 1 -> this->worker(1)
-    Thread 2 -> this->worker(2)
-    */
-
-    for (std::size_t i = 0; i < drones_.size(); ++i) {
-        threads.emplace_back(
-            &ParallelSimulation::worker, // member function to execute. 
-            this,                        // call that member fucntion of ParallelSimulation
-            i                            // agument pass to woker
-        );
+ParallelSimulationStatus ParallelSimulation::run(
+    StopToken stop,
+    Deadline deadline)
+{
+    // Set before any thread starts: the workers only read them.
+    stop_token_ = std::move(stop);
+    deadline_ = deadline;
+    stop_reason_.store(StopReason::None);
+
+    std::thread publisher_thread;
+
+    if (snapshot_interval_.count() > 0) {
+        {
+            std::lock_guard<std::mutex> lock(publisher_mutex_);
+            workers_done_ = false;
+        }
+
+        publisher_thread =
+            std::thread(&ParallelSimulation::publisher, this);
     }
 
-    for (auto& thread : threads) {
-        thread.join();
+    if (execution_ == ParallelExecution::ThreadPool) {
+        run_pool();
+    } else if (execution_ == ParallelExecution::Lockstep) {
+        run_lockstep();
+    } else {
+        std::vector<std::thread> threads;
+        /*
+
+        Thread 0 -> this->worker(0)
+        Thread 1 -> this->worker(1)
+        Thread 2 -> this->worker(2)
+        */
+
+        for (std::size_t i = 0; i < drone_ids_.size(); ++i) {
+            threads.emplace_back(
+                &ParallelSimulation::worker, // member function to execute. 
+                this,                        // call that member fucntion of ParallelSimulation
+                i                            // agument pass to woker
+            );
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    if (publisher_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(publisher_mutex_);
+            workers_done_ = true;
+        }
+
+        publisher_wakeup_.notify_one();
+        publisher_thread.join();
     }
 
-    if (target_found_.load()) {
+    if (target_found()) {
         return ParallelSimulationStatus::TargetFound;
     }
 
+    switch (stop_reason_.load()) {
+        case StopReason::Cancelled:
+            return ParallelSimulationStatus::Cancelled;
+        case StopReason::DeadlineExceeded:
+            return ParallelSimulationStatus::DeadlineExceeded;
+        case StopReason::None:
+            break;
+    }
+
     return ParallelSimulationStatus::Stuck;
 }
\ No newline at end of file
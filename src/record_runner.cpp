@@ -0,0 +1,201 @@
+#include "aeroswarm/app/record_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "aeroswarm/live/frame_recorder.hpp"
+#include "aeroswarm/parallel/simulation.hpp"
+#include "aeroswarm/parallel/terrain.hpp"
+
+namespace {
+
+int frame_cell_size(const Scenario& scenario, const RecordConfig& config) {
+    if (config.cell_size > 0) {
+        return config.cell_size;
+    }
+
+    return std::clamp(
+        1024 / std::max(scenario.width, scenario.height),
+        1,
+        20
+    );
+}
+
+
+std::string replace_all(std::string text,
+                        const std::string& from,
+                        const std::string& to)
+{
+    for (std::size_t at = text.find(from);
+         at != std::string::npos;
+         at = text.find(from, at + to.size())) {
+        text.replace(at, from.size(), to);
+    }
+
+    return text;
+}
+
+
+/*
+Same threading as parallel-sdl, with the recorder in place of the
+window:
+
+    simulation thread   simulation.run()
+    this thread         latest_snapshot() -> recorder.record(), every
+                        frame_interval
+    writer thread       raster + sink (inside FrameRecorder)
+*/
+template <typename Sink>
+int record_simulation(const Scenario& scenario,
+                      const RecordConfig& config,
+                      int cell_size,
+                      Sink sink)
+{
+    ParallelTerrain terrain{
+        scenario.width,
+        scenario.height
+    };
+
+    terrain.set_target(scenario.target);
+
+    terrain.set_obstacles(scenario.obstacles);
+
+    ParallelSimulationOptions options;
+    options.update_interval = config.update_interval;
+    options.snapshot_interval = config.frame_interval;
+
+    ParallelSimulation simulation{
+        terrain,
+        scenario.drones,
+        scenario.seed,
+        options
+    };
+
+    FrameRecorder<Sink> recorder{
+        scenario.width,
+        scenario.height,
+        cell_size,
+        std::move(sink),
+        config.queue_capacity
+    };
+
+    std::atomic<bool> simulation_finished{false};
+
+    ParallelSimulationStatus final_status{
+        ParallelSimulationStatus::Stuck
+    };
+
+    // A failing recorder stops the simulation instead of leaving it
+    // running with nobody watching.
+    StopSource stop_source;
+
+    std::thread simulation_thread([&]() {
+        final_status = simulation.run(stop_source.get_token());
+        simulation_finished.store(true);
+    });
+
+    try {
+        while (!simulation_finished.load()) {
+            recorder.record(
+                simulation.latest_snapshot(recorder.visited_epoch())
+            );
+
+            std::this_thread::sleep_for(config.frame_interval);
+        }
+
+        simulation_thread.join();
+
+        // The final state, complete.
+        recorder.record(simulation.snapshot(recorder.visited_epoch()));
+        recorder.finish();
+    } catch (const std::exception& error) {
+        stop_source.request_stop();
+
+        if (simulation_thread.joinable()) {
+            simulation_thread.join();
+        }
+
+        std::cerr << "Recording failed: " << error.what() << '\n';
+        return 1;
+    }
+
+    if (final_status == ParallelSimulationStatus::TargetFound) {
+        std::cout << "Recorded simulation: target found\n";
+    } else {
+        std::cout << "Recorded simulation: stuck\n";
+    }
+
+    std::cout
+        << "Frames: "
+        << recorder.frames_written()
+        << " -> "
+        << config.output
+        << '\n';
+
+    return 0;
+}
+
+} // namespace
+
+
+int run_record(const Scenario& scenario, const RecordConfig& config) {
+    const int cell_size = frame_cell_size(scenario, config);
+
+    try {
+        switch (config.format) {
+        case RecordFormat::Stream: {
+            std::ofstream file{config.output, std::ios::binary};
+
+            if (!file) {
+                std::cerr << "Cannot open " << config.output << '\n';
+                return 1;
+            }
+
+            return record_simulation(
+                scenario,
+                config,
+                cell_size,
+                StreamFrameSink{file, scenario.width, scenario.height}
+            );
+        }
+
+        case RecordFormat::Ppm:
+            return record_simulation(
+                scenario,
+                config,
+                cell_size,
+                PpmFrameSink{config.output}
+            );
+
+        case RecordFormat::Pipe: {
+            const std::string command = replace_all(
+                replace_all(
+                    config.output,
+                    "{width}",
+                    std::to_string(scenario.width * cell_size)
+                ),
+                "{height}",
+                std::to_string(scenario.height * cell_size)
+            );
+
+            return record_simulation(
+                scenario,
+                config,
+                cell_size,
+                PipeFrameSink{command}
+            );
+        }
+        }
+    } catch (const std::exception& error) {
+        // Sink setup: unwritable directory, encoder not found, ...
+        std::cerr << "Recording failed: " << error.what() << '\n';
+        return 1;
+    }
+
+    return 1;
+}
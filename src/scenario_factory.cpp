@@ -1,23 +1,11 @@
 #include "aeroswarm/app/scenario_factory.hpp"
 
+#include <cstddef>
 #include <random>
 #include <vector>
 
 namespace {
 
-bool contains_position(
-    const std::vector<Position>& positions,
-    const Position& candidate)
-{
-    for (const auto& pos : positions) {
-        if (pos == candidate) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
 bool is_drone_start(
     const std::vector<Drone>& drones,
     const Position& candidate)
@@ -39,6 +27,17 @@ Scenario make_random_scenario(
     int height,
     int obstacle_count,
     unsigned int seed)
+{
+    return make_random_scenario(width, height, obstacle_count, seed, 4);
+}
+
+
+Scenario make_random_scenario(
+    int width,
+    int height,
+    int obstacle_count,
+    unsigned int seed,
+    int drone_count)
 {
     Scenario scenario;
 
@@ -46,14 +45,20 @@ Scenario make_random_scenario(
     scenario.height = height;
     scenario.seed = seed;
 
-    // Four drones start from the four corners.
-    scenario.drones = {
-        Drone{1, {0, 0}},
-        Drone{2, {width - 1, 0}},
-        Drone{3, {0, height - 1}},
-        Drone{4, {width - 1, height - 1}}
+    // The first four drones start from the four corners.
+    const std::vector<Position> corners{
+        {0, 0},
+        {width - 1, 0},
+        {0, height - 1},
+        {width - 1, height - 1}
     };
 
+    scenario.drones.clear();
+
+    for (int id = 1; id <= drone_count && id <= 4; ++id) {
+        scenario.drones.emplace_back(id, corners[id - 1]);
+    }
+
     std::mt19937 rng(seed);
 
     std::uniform_int_distribution<int> x_dist(
@@ -79,9 +84,43 @@ Scenario make_random_scenario(
         }
     }
 
+    // Any further drones: random cells other than the target.
+    while (static_cast<int>(scenario.drones.size()) < drone_count) {
+        Position candidate{
+            x_dist(rng),
+            y_dist(rng)
+        };
+
+        if (candidate == scenario.target) {
+            continue;
+        }
+
+        scenario.drones.emplace_back(
+            static_cast<int>(scenario.drones.size()) + 1,
+            candidate
+        );
+    }
+
     // Random unique obstacles.
     scenario.obstacles.clear();
 
+    // One flag per cell: duplicates are found in O(1), so maps with
+    // millions of obstacles are generated in linear time.
+    std::vector<bool> drone_start(
+        static_cast<std::size_t>(width) * height,
+        false
+    );
+
+    std::vector<bool> obstacle(drone_start.size(), false);
+
+    const auto cell = [width](const Position& pos) {
+        return static_cast<std::size_t>(pos.y) * width + pos.x;
+    };
+
+    for (const auto& drone : scenario.drones) {
+        drone_start[cell(drone.position())] = true;
+    }
+
     while (
         static_cast<int>(scenario.obstacles.size())
         < obstacle_count)
@@ -97,17 +136,16 @@ Scenario make_random_scenario(
         }
 
         // Never block a drone's starting position.
-        if (is_drone_start(scenario.drones, candidate)) {
+        if (drone_start[cell(candidate)]) {
             continue;
         }
 
         // Avoid duplicate obstacles.
-        if (contains_position(
-                scenario.obstacles,
-                candidate)) {
+        if (obstacle[cell(candidate)]) {
             continue;
         }
 
+        obstacle[cell(candidate)] = true;
         scenario.obstacles.push_back(candidate);
     }
 
@@ -1,17 +1,55 @@
 #include "aeroswarm/live/sdl_renderer.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <stdexcept>
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 
+namespace {
+
+// Drones and the target stay visible on zoomed-out maps.
+constexpr float min_marker_pixels = 3.0f;
+
+
+float cell_pixels_for(
+    int grid_width,
+    int grid_height,
+    int cell_size,
+    SdlRenderMode mode)
+{
+    if (mode == SdlRenderMode::Cells) {
+        return static_cast<float>(cell_size);
+    }
+
+    return std::min(
+        static_cast<float>(cell_size),
+        static_cast<float>(SdlRenderer::max_texel_map_pixels) /
+            static_cast<float>(std::max(grid_width, grid_height))
+    );
+}
+
+} // namespace
+
+
 SdlRenderer::SdlRenderer(
     int grid_width,
     int grid_height,
-    int cell_size)
+    int cell_size,
+    SdlRenderMode mode)
     : grid_width_(grid_width),
       grid_height_(grid_height),
-      cell_size_(cell_size)
+      cell_size_(cell_size),
+      mode_(mode),
+      cell_pixels_(cell_pixels_for(grid_width, grid_height, cell_size, mode)),
+      map_width_(static_cast<int>(
+          std::ceil(static_cast<float>(grid_width) * cell_pixels_))),
+      map_height_(static_cast<int>(
+          std::ceil(static_cast<float>(grid_height) * cell_pixels_))),
+      zoom_(cell_pixels_),
+      max_zoom_(std::max(cell_pixels_, 4.0f * static_cast<float>(cell_size)))
 {
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         throw std::runtime_error(SDL_GetError());
@@ -22,9 +60,8 @@ SdlRenderer::SdlRenderer(
         throw std::runtime_error(SDL_GetError());
     }
 
-    const int terrain_width = grid_width_ * cell_size_;
-    const int window_width  = terrain_width + telemetry_width_;
-    const int window_height = grid_height_ * cell_size_;
+    const int window_width  = map_width_ + telemetry_width_;
+    const int window_height = map_height_;
 
     if (!SDL_CreateWindowAndRenderer(
             "AeroSwarm Live Monitor",
@@ -50,9 +87,41 @@ SdlRenderer::SdlRenderer(
 
         throw std::runtime_error(SDL_GetError());
     }
+
+    if (!build_glyph_atlas()) {
+        const std::string error = SDL_GetError();
+
+        TTF_CloseFont(font_);
+        SDL_DestroyRenderer(renderer_);
+        SDL_DestroyWindow(window_);
+        TTF_Quit();
+        SDL_Quit();
+
+        throw std::runtime_error(error);
+    }
 }
 
 SdlRenderer::~SdlRenderer() {
+    for (auto& entry : labels_) {
+        SDL_DestroyTexture(entry.second.texture);
+    }
+
+    if (glyph_atlas_) {
+        SDL_DestroyTexture(glyph_atlas_);
+    }
+
+    if (static_layer_) {
+        SDL_DestroyTexture(static_layer_);
+    }
+
+    if (cell_texture_) {
+        SDL_DestroyTexture(cell_texture_);
+    }
+
+    if (lod_texture_) {
+        SDL_DestroyTexture(lod_texture_);
+    }
+
     if (font_) {
         TTF_CloseFont(font_);
     }
@@ -76,26 +145,203 @@ bool SdlRenderer::process_events() {
         if (event.type == SDL_EVENT_QUIT) {
             return false;
         }
+
+        const float map_right = static_cast<float>(map_width_);
+
+        if (event.type == SDL_EVENT_MOUSE_WHEEL &&
+            event.wheel.mouse_x < map_right) {
+            zoom_at(
+                std::pow(1.25f, event.wheel.y),
+                event.wheel.mouse_x,
+                event.wheel.mouse_y
+            );
+        }
+
+        if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN &&
+            event.button.x < map_right &&
+            (event.button.button == SDL_BUTTON_LEFT ||
+             event.button.button == SDL_BUTTON_MIDDLE)) {
+            dragging_ = true;
+        }
+
+        if (event.type == SDL_EVENT_MOUSE_BUTTON_UP) {
+            dragging_ = false;
+        }
+
+        if (event.type == SDL_EVENT_MOUSE_MOTION && dragging_) {
+            pan(-event.motion.xrel, -event.motion.yrel);
+        }
+
+        if (event.type == SDL_EVENT_KEY_DOWN) {
+            const float center_x = map_right * 0.5f;
+            const float center_y = static_cast<float>(map_height_) * 0.5f;
+
+            // Arrow keys move the view by an eighth of the map area.
+            const float step = map_right / 8.0f;
+
+            switch (event.key.key) {
+            case SDLK_LEFT:     pan(-step, 0.0f); break;
+            case SDLK_RIGHT:    pan(step, 0.0f); break;
+            case SDLK_UP:       pan(0.0f, -step); break;
+            case SDLK_DOWN:     pan(0.0f, step); break;
+
+            case SDLK_PLUS:
+            case SDLK_EQUALS:
+            case SDLK_KP_PLUS:
+                zoom_at(1.25f, center_x, center_y);
+                break;
+
+            case SDLK_MINUS:
+            case SDLK_KP_MINUS:
+                zoom_at(0.8f, center_x, center_y);
+                break;
+
+            case SDLK_0:
+                zoom_ = cell_pixels_;
+                view_x_ = 0.0f;
+                view_y_ = 0.0f;
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        // Render-target contents are lost with the device: redraw
+        // the cached static layer on the next frame.
+        if (event.type == SDL_EVENT_RENDER_TARGETS_RESET ||
+            event.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+            static_layer_valid_ = false;
+        }
+
+        // Every texture is lost with the device: create them again.
+        if (event.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+            if (static_layer_) {
+                SDL_DestroyTexture(static_layer_);
+                static_layer_ = nullptr;
+            }
+
+            if (cell_texture_) {
+                SDL_DestroyTexture(cell_texture_);
+                cell_texture_ = nullptr;
+            }
+
+            if (lod_texture_) {
+                SDL_DestroyTexture(lod_texture_);
+                lod_texture_ = nullptr;
+                lod_valid_ = false;
+            }
+
+            for (auto& entry : labels_) {
+                SDL_DestroyTexture(entry.second.texture);
+            }
+
+            labels_.clear();
+
+            if (glyph_atlas_) {
+                SDL_DestroyTexture(glyph_atlas_);
+                glyph_atlas_ = nullptr;
+            }
+
+            // If this fails the panel is drawn without text.
+            build_glyph_atlas();
+        }
     }
 
     return true;
 }
 
 
+SdlRenderer::CellWindow SdlRenderer::visible_cells() const {
+    return CellWindow{
+        view_x_,
+        view_y_,
+        std::min(
+            static_cast<float>(grid_width_) - view_x_,
+            static_cast<float>(map_width_) / zoom_
+        ),
+        std::min(
+            static_cast<float>(grid_height_) - view_y_,
+            static_cast<float>(map_height_) / zoom_
+        )
+    };
+}
+
+
+// Zooms by `factor`, keeping the cell under (screen_x, screen_y) there.
+void SdlRenderer::zoom_at(
+    float factor,
+    float screen_x,
+    float screen_y)
+{
+    const float cell_x = view_x_ + screen_x / zoom_;
+    const float cell_y = view_y_ + screen_y / zoom_;
+
+    zoom_ = std::clamp(zoom_ * factor, cell_pixels_, max_zoom_);
+
+    view_x_ = cell_x - screen_x / zoom_;
+    view_y_ = cell_y - screen_y / zoom_;
+
+    clamp_view();
+}
+
+
+// Moves the view by (dx, dy) screen pixels.
+void SdlRenderer::pan(float dx, float dy) {
+    view_x_ += dx / zoom_;
+    view_y_ += dy / zoom_;
+
+    clamp_view();
+}
+
+
+// Keeps the view inside the map.
+void SdlRenderer::clamp_view() {
+    const float max_x = std::max(
+        0.0f,
+        static_cast<float>(grid_width_) -
+            static_cast<float>(map_width_) / zoom_
+    );
+
+    const float max_y = std::max(
+        0.0f,
+        static_cast<float>(grid_height_) -
+            static_cast<float>(map_height_) / zoom_
+    );
+
+    view_x_ = std::clamp(view_x_, 0.0f, max_x);
+    view_y_ = std::clamp(view_y_, 0.0f, max_y);
+}
+
+
+SdlRenderer::CellLayout SdlRenderer::screen_layout() const {
+    return CellLayout{
+        -view_x_ * zoom_,
+        -view_y_ * zoom_,
+        zoom_
+    };
+}
+
+
+SdlRenderer::CellLayout SdlRenderer::texture_layout() const {
+    return CellLayout{
+        0.0f,
+        0.0f,
+        static_cast<float>(cell_size_)
+    };
+}
+
+
 
 void SdlRenderer::draw_telemetry_panel() {
     const float panel_x =
-        static_cast<float>(
-            grid_width_ * cell_size_
-        );
+        static_cast<float>(map_width_);
 
     SDL_FRect panel{
         panel_x,
         0.0f,
         static_cast<float>(telemetry_width_),
-        static_cast<float>(
-            grid_height_ * cell_size_
-        )
+        static_cast<float>(map_height_)
     };
 
     SDL_SetRenderDrawColor(
@@ -110,90 +356,367 @@ void SdlRenderer::draw_telemetry_panel() {
         renderer_,
         &panel
     );
+
+    ++stats_.draw_calls;
 }
 
 
-void SdlRenderer::draw_cell(const Position& pos) {
-    SDL_FRect rect{
-        static_cast<float>(pos.x * cell_size_),
-        static_cast<float>(pos.y * cell_size_),
-        static_cast<float>(cell_size_),
-        static_cast<float>(cell_size_)
-    };
+SDL_FRect SdlRenderer::cell_rect(
+    const CellLayout& layout,
+    const Position& pos,
+    float inset,
+    float min_extent) const
+{
+    const float extent = std::max(
+        layout.cell_pixels * (1.0f - 2.0f * inset),
+        min_extent
+    );
 
-    SDL_RenderFillRect(renderer_, &rect);
-}
+    // Centered on the cell, so markers grow evenly around it.
+    const float center_x = layout.origin_x +
+        (static_cast<float>(pos.x) + 0.5f) * layout.cell_pixels;
 
+    const float center_y = layout.origin_y +
+        (static_cast<float>(pos.y) + 0.5f) * layout.cell_pixels;
 
-void SdlRenderer::draw_visited(const Position& pos) {
-    SDL_SetRenderDrawColor(renderer_, 55, 55, 65, 255);
-    draw_cell(pos);
+    return SDL_FRect{
+        center_x - extent * 0.5f,
+        center_y - extent * 0.5f,
+        extent,
+        extent
+    };
 }
 
-void SdlRenderer::draw_obstacle(const Position& pos) {
-    SDL_SetRenderDrawColor(renderer_, 110, 90, 70, 255);
-    draw_cell(pos);
-}
 
-void SdlRenderer::draw_target(const Position& pos) {
-    SDL_SetRenderDrawColor(renderer_, 220, 60, 60, 255);
-    draw_cell(pos);
-}
+void SdlRenderer::draw_cells(
+    const CellLayout& layout,
+    const std::vector<Position>& cells,
+    float inset,
+    float min_extent)
+{
+    if (cells.empty()) {
+        return;
+    }
 
-void SdlRenderer::draw_drone(const Position& pos) {
-    SDL_SetRenderDrawColor(renderer_, 60, 160, 230, 255);
+    rects_.clear();
+    rects_.reserve(cells.size());
 
-    const float margin =
-        static_cast<float>(cell_size_) * 0.20f;
+    for (const auto& pos : cells) {
+        rects_.push_back(cell_rect(layout, pos, inset, min_extent));
+    }
 
-    SDL_FRect rect{
-        static_cast<float>(pos.x * cell_size_) + margin,
-        static_cast<float>(pos.y * cell_size_) + margin,
-        static_cast<float>(cell_size_) - 2.0f * margin,
-        static_cast<float>(cell_size_) - 2.0f * margin
-    };
+    SDL_RenderFillRects(
+        renderer_,
+        rects_.data(),
+        static_cast<int>(rects_.size())
+    );
 
-    SDL_RenderFillRect(renderer_, &rect);
+    ++stats_.draw_calls;
 }
 
 
-void SdlRenderer::draw_grid() {
+/*
+Grid lines as one batch of 1 px wide rectangles (SDL_RenderLines only
+batches connected polylines).
+*/
+void SdlRenderer::draw_grid(const CellLayout& layout) {
     SDL_SetRenderDrawColor(renderer_, 70, 70, 70, 255);
 
     const float width =
-        static_cast<float>(grid_width_ * cell_size_);
+        static_cast<float>(grid_width_) * layout.cell_pixels;
 
     const float height =
-        static_cast<float>(grid_height_ * cell_size_);
+        static_cast<float>(grid_height_) * layout.cell_pixels;
+
+    rects_.clear();
+    rects_.reserve(
+        static_cast<std::size_t>(grid_width_ + grid_height_ + 2)
+    );
 
     for (int x = 0; x <= grid_width_; ++x) {
-        const float screen_x =
-            static_cast<float>(x * cell_size_);
+        rects_.push_back(SDL_FRect{
+            layout.origin_x + static_cast<float>(x) * layout.cell_pixels,
+            layout.origin_y,
+            1.0f,
+            height
+        });
+    }
+
+    for (int y = 0; y <= grid_height_; ++y) {
+        rects_.push_back(SDL_FRect{
+            layout.origin_x,
+            layout.origin_y + static_cast<float>(y) * layout.cell_pixels,
+            width,
+            1.0f
+        });
+    }
+
+    SDL_RenderFillRects(
+        renderer_,
+        rects_.data(),
+        static_cast<int>(rects_.size())
+    );
+
+    ++stats_.draw_calls;
+}
+
+
+// Background, grid and obstacles: everything that does not change
+// between frames.
+void SdlRenderer::draw_static_layer(
+    const SharedPositions& obstacles,
+    const CellLayout& layout)
+{
+    SDL_SetRenderDrawColor(renderer_, 25, 25, 25, 255);
+    SDL_RenderClear(renderer_);
+
+    draw_grid(layout);
+
+    if (obstacles) {
+        SDL_SetRenderDrawColor(renderer_, 110, 90, 70, 255);
+        draw_cells(layout, *obstacles);
+    }
+}
+
+
+void SdlRenderer::update_static_layer(
+    const SharedPositions& obstacles)
+{
+    if (static_layer_valid_ && obstacles == static_layer_obstacles_) {
+        return;
+    }
 
-        SDL_RenderLine(
+    if (!static_layer_) {
+        // Fails for maps larger than the GPU's texture limit:
+        // render() then draws the static layer every frame.
+        static_layer_ = SDL_CreateTexture(
             renderer_,
-            screen_x,
-            0.0f,
-            screen_x,
-            height
+            SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_TARGET,
+            map_width_,
+            map_height_
         );
+
+        if (!static_layer_) {
+            return;
+        }
     }
 
-    for (int y = 0; y <= grid_height_; ++y) {
-        const float screen_y =
-            static_cast<float>(y * cell_size_);
+    SDL_SetRenderTarget(renderer_, static_layer_);
+    draw_static_layer(obstacles, texture_layout());
+    SDL_SetRenderTarget(renderer_, nullptr);
+
+    static_layer_obstacles_ = obstacles;
+    static_layer_valid_ = true;
+}
+
+
+/*
+Uploads the tiles of the map texture that changed since the last
+frame: all of them after a new obstacle list or a visited reset,
+otherwise only those holding newly visited cells.
 
-        SDL_RenderLine(
+Locked texels are write-only, so every locked tile is written in full
+from TexelGrid, never patched.
+*/
+void SdlRenderer::update_cell_texture(
+    const SharedPositions& obstacles)
+{
+    if (!cell_texture_) {
+        cell_texture_ = SDL_CreateTexture(
             renderer_,
-            0.0f,
-            screen_y,
-            width,
-            screen_y
+            SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_STREAMING,
+            grid_width_,
+            grid_height_
         );
+
+        // Larger than the GPU's texture limit: nothing to fall back to.
+        if (!cell_texture_) {
+            throw std::runtime_error(SDL_GetError());
+        }
+
+        // Only drawn at one pixel per cell or more (see lod_level()):
+        // magnified cells stay sharp squares.
+        SDL_SetTextureScaleMode(cell_texture_, SDL_SCALEMODE_NEAREST);
+
+        // A new texture holds no texels yet.
+        texels_->mark_all_dirty();
+    }
+
+    if (obstacles != texel_obstacles_) {
+        if (obstacles) {
+            texels_->set_obstacles(*obstacles);
+            pyramid_->set_obstacles(*obstacles);
+        } else {
+            texels_->set_obstacles({});
+            pyramid_->set_obstacles({});
+        }
+
+        texel_obstacles_ = obstacles;
     }
+
+    texels_->take_dirty_tiles([this](const TexelTile& tile) {
+        const SDL_Rect area{
+            tile.x,
+            tile.y,
+            tile.width,
+            tile.height
+        };
+
+        void* pixels = nullptr;
+        int pitch = 0;
+
+        if (!SDL_LockTexture(cell_texture_, &area, &pixels, &pitch)) {
+            throw std::runtime_error(SDL_GetError());
+        }
+
+        texels_->fill(tile, pixels, pitch);
+
+        SDL_UnlockTexture(cell_texture_);
+    });
 }
 
 
+int SdlRenderer::lod_level() const {
+    int level = 0;
+
+    // Smallest level whose blocks cover at least one pixel.
+    while (level < pyramid_->level_count() &&
+           static_cast<float>(1 << level) * zoom_ < 1.0f) {
+        ++level;
+    }
+
+    return level;
+}
+
+
+/*
+Texels mode, the visible part of the map:
+
+    lod_level() == 0   the cell texture itself, magnified
+    otherwise          the visible blocks of that pyramid level,
+                       written into lod_texture_ (never more blocks
+                       than pixels of the map area, plus the two
+                       partly visible edges) and scaled into place
+
+Either way the work depends on the window size, not on the map area.
+*/
+void SdlRenderer::draw_texel_map() {
+    const CellWindow cells = visible_cells();
+
+    const SDL_FRect destination{
+        0.0f,
+        0.0f,
+        cells.width * zoom_,
+        cells.height * zoom_
+    };
+
+    const int level = lod_level();
+
+    if (level == 0) {
+        const SDL_FRect source{
+            cells.x,
+            cells.y,
+            cells.width,
+            cells.height
+        };
+
+        SDL_RenderTexture(
+            renderer_,
+            cell_texture_,
+            &source,
+            &destination
+        );
+
+        ++stats_.draw_calls;
+        return;
+    }
+
+    if (!lod_texture_) {
+        lod_texture_ = SDL_CreateTexture(
+            renderer_,
+            SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_STREAMING,
+            map_width_ + 2,
+            map_height_ + 2
+        );
+
+        if (!lod_texture_) {
+            throw std::runtime_error(SDL_GetError());
+        }
+
+        SDL_SetTextureScaleMode(lod_texture_, SDL_SCALEMODE_NEAREST);
+        lod_valid_ = false;
+    }
+
+    const float block = static_cast<float>(1 << level);
+
+    const int first_x = static_cast<int>(std::floor(cells.x / block));
+    const int first_y = static_cast<int>(std::floor(cells.y / block));
+
+    const int last_x = std::min(
+        pyramid_->level_width(level),
+        static_cast<int>(std::ceil((cells.x + cells.width) / block))
+    );
+
+    const int last_y = std::min(
+        pyramid_->level_height(level),
+        static_cast<int>(std::ceil((cells.y + cells.height) / block))
+    );
+
+    const LodWindow window{
+        level,
+        first_x,
+        first_y,
+        std::min(last_x - first_x, map_width_ + 2),
+        std::min(last_y - first_y, map_height_ + 2),
+        pyramid_->version()
+    };
+
+    if (!lod_valid_ || !(window == lod_window_)) {
+        const SDL_Rect area{0, 0, window.columns, window.rows};
+
+        void* pixels = nullptr;
+        int pitch = 0;
+
+        if (!SDL_LockTexture(lod_texture_, &area, &pixels, &pitch)) {
+            throw std::runtime_error(SDL_GetError());
+        }
+
+        pyramid_->fill(
+            level,
+            window.block_x,
+            window.block_y,
+            window.columns,
+            window.rows,
+            pixels,
+            pitch
+        );
+
+        SDL_UnlockTexture(lod_texture_);
+
+        lod_window_ = window;
+        lod_valid_ = true;
+    }
+
+    const SDL_FRect source{
+        cells.x / block - static_cast<float>(first_x),
+        cells.y / block - static_cast<float>(first_y),
+        cells.width / block,
+        cells.height / block
+    };
+
+    SDL_RenderTexture(
+        renderer_,
+        lod_texture_,
+        &source,
+        &destination
+    );
+
+    ++stats_.draw_calls;
+}
+
 
 // void SdlRenderer::render(const SimulationSnapshot& snapshot) {
 //     // Clear the entire window first.
@@ -230,6 +753,11 @@ void SdlRenderer::draw_grid() {
 void SdlRenderer::render(
     const SimulationSnapshot& snapshot)
 {
+    const auto frame_start =
+        std::chrono::steady_clock::now();
+
+    stats_.draw_calls = 0;
+
     SDL_SetRenderDrawColor(
         renderer_,
         25,
@@ -240,86 +768,388 @@ void SdlRenderer::render(
 
     SDL_RenderClear(renderer_);
 
-    draw_grid();
+    /*
+    snapshot.visited_cells is a delta:
+
+        begin == 0                full list, start over
+        begin == visited_epoch_   continues where we stopped, append
+        anything else             delta from another epoch, skip it;
+                                  the next snapshot asked with
+                                  visited_epoch_ fills the gap
+    */
+    if (mode_ == SdlRenderMode::Texels && !texels_) {
+        texels_.emplace(grid_width_, grid_height_);
+        pyramid_.emplace(grid_width_, grid_height_);
+    }
+
+    if (snapshot.visited_epoch_begin == 0) {
+        visited_cells_.clear();
+        visited_epoch_ = 0;
 
-    for (const auto& pos : snapshot.visited_cells) {
-        draw_visited(pos);
+        if (texels_) {
+            texels_->clear_visited();
+            pyramid_->clear_visited();
+        }
     }
 
-    for (const auto& pos : snapshot.obstacle_positions) {
-        draw_obstacle(pos);
+    if (snapshot.visited_epoch_begin == visited_epoch_) {
+        if (texels_) {
+            for (const auto& pos : snapshot.visited_cells) {
+                if (texels_->mark_visited(pos)) {
+                    pyramid_->add_visited(pos);
+                }
+            }
+        } else {
+            visited_cells_.insert(
+                visited_cells_.end(),
+                snapshot.visited_cells.begin(),
+                snapshot.visited_cells.end()
+            );
+        }
+
+        visited_epoch_ = snapshot.visited_epoch;
     }
 
-    if (snapshot.target.has_value()) {
-        draw_target(
-            snapshot.target.value()
-        );
+    const CellLayout layout = screen_layout();
+
+    if (mode_ == SdlRenderMode::Texels) {
+        update_cell_texture(snapshot.obstacle_positions);
+        draw_texel_map();
+    } else {
+        update_static_layer(snapshot.obstacle_positions);
+
+        if (static_layer_) {
+            // The static layer is unscrolled, at cell_size_ per cell.
+            const CellWindow cells = visible_cells();
+            const float texture_scale = static_cast<float>(cell_size_);
+
+            const SDL_FRect source{
+                cells.x * texture_scale,
+                cells.y * texture_scale,
+                cells.width * texture_scale,
+                cells.height * texture_scale
+            };
+
+            const SDL_FRect destination{
+                0.0f,
+                0.0f,
+                cells.width * zoom_,
+                cells.height * zoom_
+            };
+
+            SDL_RenderTexture(
+                renderer_,
+                static_layer_,
+                &source,
+                &destination
+            );
+
+            ++stats_.draw_calls;
+        } else {
+            draw_static_layer(snapshot.obstacle_positions, layout);
+        }
+
+        SDL_SetRenderDrawColor(renderer_, 55, 55, 65, 255);
+        draw_cells(layout, visited_cells_);
     }
 
-    for (const auto& pos : snapshot.drone_positions) {
-        draw_drone(pos);
+    if (snapshot.target.has_value()) {
+        const SDL_FRect rect =
+            cell_rect(
+                layout,
+                snapshot.target.value(),
+                0.0f,
+                min_marker_pixels
+            );
+
+        SDL_SetRenderDrawColor(renderer_, 220, 60, 60, 255);
+        SDL_RenderFillRect(renderer_, &rect);
+
+        ++stats_.draw_calls;
     }
 
+    SDL_SetRenderDrawColor(renderer_, 60, 160, 230, 255);
+    draw_cells(layout, snapshot.drone_positions, 0.20f, min_marker_pixels);
+
     // UI layer
     draw_telemetry_panel();
     draw_telemetry(snapshot);
 
     SDL_RenderPresent(renderer_);
+
+    ++stats_.frames;
+    stats_.visited_cells = visited_epoch_;
+    stats_.render_seconds +=
+        std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - frame_start
+        ).count();
 }
 
 
-void SdlRenderer::draw_text(
-    const std::string& text,
-    float x,
-    float y)
-{
-    SDL_Color color{
-        230,
-        235,
-        240,
-        255
+/*
+Atlas layout, one row, glyphs in character order:
+
+    [ ' ' | '!' | '"' | ... | '~' ]   atlas_height_ = font height
+
+Each glyph is rendered white; draw_text() tints it through the vertex
+color. Kerning is not applied, which is fine for short numeric lines.
+*/
+bool SdlRenderer::build_glyph_atlas() {
+    std::array<SDL_Surface*, last_glyph_ - first_glyph_ + 1> surfaces{};
+
+    const SDL_Color white{255, 255, 255, 255};
+
+    int width = 0;
+    int height = 0;
+
+    const auto destroy_surfaces = [&surfaces]() {
+        for (auto* surface : surfaces) {
+            if (surface) {
+                SDL_DestroySurface(surface);
+            }
+        }
     };
 
-    SDL_Surface* surface =
-        TTF_RenderText_Blended(
+    for (char ch = first_glyph_; ch <= last_glyph_; ++ch) {
+        const std::size_t slot =
+            static_cast<std::size_t>(ch - first_glyph_);
+
+        int advance = 0;
+
+        if (!TTF_GetGlyphMetrics(
+                font_,
+                static_cast<Uint32>(ch),
+                nullptr,
+                nullptr,
+                nullptr,
+                nullptr,
+                &advance)) {
+            destroy_surfaces();
+            return false;
+        }
+
+        glyphs_[slot].advance = static_cast<float>(advance);
+
+        // The space has nothing to draw, only an advance.
+        if (ch == ' ') {
+            continue;
+        }
+
+        surfaces[slot] = TTF_RenderGlyph_Blended(
             font_,
-            text.c_str(),
-            text.size(),
-            color
+            static_cast<Uint32>(ch),
+            white
         );
 
-    if (!surface) {
-        throw std::runtime_error(SDL_GetError());
+        if (!surfaces[slot]) {
+            destroy_surfaces();
+            return false;
+        }
+
+        glyphs_[slot].x = static_cast<float>(width);
+        glyphs_[slot].width = static_cast<float>(surfaces[slot]->w);
+
+        width += surfaces[slot]->w;
+        height = std::max(height, surfaces[slot]->h);
     }
 
-    SDL_Texture* texture =
+    SDL_Surface* atlas =
+        SDL_CreateSurface(
+            std::max(width, 1),
+            std::max(height, 1),
+            SDL_PIXELFORMAT_RGBA32
+        );
+
+    if (!atlas) {
+        destroy_surfaces();
+        return false;
+    }
+
+    for (std::size_t slot = 0; slot < surfaces.size(); ++slot) {
+        if (!surfaces[slot]) {
+            continue;
+        }
+
+        SDL_Rect destination{
+            static_cast<int>(glyphs_[slot].x),
+            0,
+            surfaces[slot]->w,
+            surfaces[slot]->h
+        };
+
+        // Copy the glyph's alpha as is, not blended onto the
+        // (transparent) atlas.
+        SDL_SetSurfaceBlendMode(surfaces[slot], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surfaces[slot], nullptr, atlas, &destination);
+    }
+
+    destroy_surfaces();
+
+    glyph_atlas_ =
         SDL_CreateTextureFromSurface(
             renderer_,
-            surface
+            atlas
         );
 
-    if (!texture) {
+    atlas_width_ = static_cast<float>(atlas->w);
+    atlas_height_ = static_cast<float>(atlas->h);
+
+    SDL_DestroySurface(atlas);
+
+    if (!glyph_atlas_) {
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(glyph_atlas_, SDL_BLENDMODE_BLEND);
+
+    return true;
+}
+
+
+void SdlRenderer::draw_text(
+    const std::string& text,
+    float x,
+    float y)
+{
+    const SDL_FColor color{
+        230.0f / 255.0f,
+        235.0f / 255.0f,
+        240.0f / 255.0f,
+        1.0f
+    };
+
+    float pen_x = x;
+
+    for (const char ch : text) {
+        // Outside the atlas: draw as '?'.
+        const char shown =
+            ch >= first_glyph_ && ch <= last_glyph_ ? ch : '?';
+
+        const Glyph& glyph =
+            glyphs_[static_cast<std::size_t>(shown - first_glyph_)];
+
+        if (glyph.width > 0.0f) {
+            const float left = glyph.x / atlas_width_;
+            const float right = (glyph.x + glyph.width) / atlas_width_;
+
+            const int base =
+                static_cast<int>(text_vertices_.size());
+
+            text_vertices_.push_back(SDL_Vertex{
+                {pen_x, y}, color, {left, 0.0f}
+            });
+            text_vertices_.push_back(SDL_Vertex{
+                {pen_x + glyph.width, y}, color, {right, 0.0f}
+            });
+            text_vertices_.push_back(SDL_Vertex{
+                {pen_x + glyph.width, y + atlas_height_}, color, {right, 1.0f}
+            });
+            text_vertices_.push_back(SDL_Vertex{
+                {pen_x, y + atlas_height_}, color, {left, 1.0f}
+            });
+
+            text_indices_.insert(
+                text_indices_.end(),
+                {base, base + 1, base + 2, base, base + 2, base + 3}
+            );
+        }
+
+        pen_x += glyph.advance;
+    }
+}
+
+
+void SdlRenderer::flush_text() {
+    if (!glyph_atlas_) {
+        text_vertices_.clear();
+        text_indices_.clear();
+    }
+
+    if (text_indices_.empty()) {
+        return;
+    }
+
+    SDL_RenderGeometry(
+        renderer_,
+        glyph_atlas_,
+        text_vertices_.data(),
+        static_cast<int>(text_vertices_.size()),
+        text_indices_.data(),
+        static_cast<int>(text_indices_.size())
+    );
+
+    ++stats_.draw_calls;
+
+    text_vertices_.clear();
+    text_indices_.clear();
+}
+
+
+void SdlRenderer::draw_label(
+    const std::string& text,
+    float x,
+    float y)
+{
+    auto found = labels_.find(text);
+
+    if (found == labels_.end()) {
+        SDL_Color color{
+            230,
+            235,
+            240,
+            255
+        };
+
+        SDL_Surface* surface =
+            TTF_RenderText_Blended(
+                font_,
+                text.c_str(),
+                text.size(),
+                color
+            );
+
+        if (!surface) {
+            throw std::runtime_error(SDL_GetError());
+        }
+
+        SDL_Texture* texture =
+            SDL_CreateTextureFromSurface(
+                renderer_,
+                surface
+            );
+
+        const Label label{
+            texture,
+            static_cast<float>(surface->w),
+            static_cast<float>(surface->h)
+        };
+
         SDL_DestroySurface(surface);
-        throw std::runtime_error(SDL_GetError());
+
+        if (!texture) {
+            throw std::runtime_error(SDL_GetError());
+        }
+
+        found = labels_.emplace(text, label).first;
     }
 
+    const Label& label = found->second;
+
     SDL_FRect destination{
         x,
         y,
-        static_cast<float>(surface->w),
-        static_cast<float>(surface->h)
+        label.width,
+        label.height
     };
 
-    SDL_DestroySurface(surface);
-
     SDL_RenderTexture(
         renderer_,
-        texture,
+        label.texture,
         nullptr,
         &destination
     );
 
-    SDL_DestroyTexture(texture);
+    ++stats_.draw_calls;
 }
 
 
@@ -327,16 +1157,14 @@ void SdlRenderer::draw_telemetry(
     const SimulationSnapshot& snapshot)
 {
     const float panel_x =
-        static_cast<float>(
-            grid_width_ * cell_size_
-        );
+        static_cast<float>(map_width_);
 
     const float left =
         panel_x + 24.0f;
 
     float y = 30.0f;
 
-    draw_text(
+    draw_label(
         "AEROSWARM LIVE",
         left,
         y
@@ -344,7 +1172,7 @@ void SdlRenderer::draw_telemetry(
 
     y += 45.0f;
 
-    draw_text(
+    draw_label(
         "STATUS",
         left,
         y
@@ -352,7 +1180,7 @@ void SdlRenderer::draw_telemetry(
 
     y += 30.0f;
 
-    draw_text(
+    draw_label(
         snapshot.target_found
             ? "TARGET FOUND"
             : "SEARCHING",
@@ -362,7 +1190,7 @@ void SdlRenderer::draw_telemetry(
 
     y += 55.0f;
 
-    draw_text(
+    draw_label(
         "SIMULATION",
         left,
         y
@@ -393,7 +1221,7 @@ void SdlRenderer::draw_telemetry(
     draw_text(
         "Visited: " +
         std::to_string(
-            snapshot.visited_cells.size()
+            snapshot.visited_epoch
         ),
         left,
         y
@@ -401,7 +1229,7 @@ void SdlRenderer::draw_telemetry(
 
     y += 55.0f;
 
-    draw_text(
+    draw_label(
         "TARGET",
         left,
         y
@@ -423,7 +1251,7 @@ void SdlRenderer::draw_telemetry(
             y
         );
     } else {
-        draw_text(
+        draw_label(
             "Position: --",
             left,
             y
@@ -432,7 +1260,7 @@ void SdlRenderer::draw_telemetry(
 
     y += 55.0f;
 
-    draw_text(
+    draw_label(
         "WINNER",
         left,
         y
@@ -450,10 +1278,13 @@ void SdlRenderer::draw_telemetry(
             y
         );
     } else {
-        draw_text(
+        draw_label(
             "--",
             left,
             y
         );
     }
+
+    // All numeric lines in one draw call.
+    flush_text();
 }
\ No newline at end of file
@@ -14,9 +14,7 @@ int run_sequential(const Scenario& scenario) {
     };
 
     terrain.set_target(scenario.target);
-    for (const auto& obstacle : scenario.obstacles) {
-        terrain.set_obstacle(obstacle);
-    }
+    terrain.set_obstacles(scenario.obstacles);
 
     Simulation simulation{
         terrain,
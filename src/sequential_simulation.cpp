@@ -4,10 +4,13 @@
 
 Simulation::Simulation(Terrain terrain,
                std::vector<Drone> drones,
-               unsigned int seed) : 
+               unsigned int seed,
+               StuckRecovery recovery) : 
                 terrain_(std::move(terrain)), 
                 drones_(std::move(drones)),
-                seed_(seed) 
+                seed_(seed),
+                recovery_(recovery),
+                routes_(drones_.size())
         {
             for (const auto& drone : drones_) {
                 terrain_.mark_visited(drone.position());
@@ -20,6 +23,10 @@ const Terrain& Simulation::terrain() const {
     return terrain_;
 }
 
+Terrain Simulation::release_terrain() {
+    return std::move(terrain_);
+}
+
 const std::vector<Drone>& Simulation::drones() const {
     return drones_;
 }
@@ -33,17 +40,28 @@ const std::optional<int>&  Simulation::winning_drone_id() const{
     return winning_drone_id_;
 }
 
+std::size_t Simulation::tick() const {
+    return tick_;
+}
 
 
 
-SimulationSnapshot Simulation::snapshot() const {
+
+SimulationSnapshot Simulation::snapshot(std::size_t visited_epoch) const {
     SimulationSnapshot snapshot;
 
     snapshot.target_found = target_found_;
     snapshot.winning_drone_id = winning_drone_id_;
     snapshot.tick = tick_;
-    snapshot.visited_cells = terrain_.visited_positions();
-    snapshot.obstacle_positions = terrain_.obstacle_positions();
+
+    // The run stops on the winning step, so tick_ is still that step.
+    if (target_found_) {
+        snapshot.winning_tick = tick_;
+    }
+    snapshot.visited_epoch_begin = visited_epoch;
+    snapshot.visited_epoch =
+        terrain_.visited_since(visited_epoch, snapshot.visited_cells);
+    snapshot.obstacle_positions = terrain_.shared_obstacle_positions();
     snapshot.target = terrain_.target_position();
 
     snapshot.drone_positions.reserve(drones_.size());
@@ -65,19 +83,16 @@ bool Simulation::step() {
 
     bool moved_any = false;
 
-    for (auto& drone : drones_) {
-        auto neighbors = terrain_.available_neighbors(drone.position());
+    for (std::size_t i = 0; i < drones_.size(); ++i) {
+        auto& drone = drones_[i];
 
-        if (neighbors.empty()) {
+        const std::optional<Position> next_cell = next_position(i);
+
+        if (!next_cell.has_value()) {
             continue;
         }
 
-        std::uniform_int_distribution<std::size_t> dist(
-            0,
-            neighbors.size() - 1
-        );
-
-        const Position next = neighbors[dist(seed_)];
+        const Position next = next_cell.value();
 
         drone.move_to(next);
         terrain_.mark_visited(next);
@@ -94,12 +109,59 @@ bool Simulation::step() {
 };
 
 
-SimulationStatus Simulation::run_until_done() {
+/*
+Exploring: a random available neighbor.
+
+Boxed in (SeekFrontier): the next cell of the drone's route to the
+nearest unvisited cell, planned here when it has none. A route whose
+frontier cell another drone has visited since is planned again.
+*/
+std::optional<Position> Simulation::next_position(std::size_t drone_index) {
+    const Drone& drone = drones_[drone_index];
+    FrontierRoute& route = routes_[drone_index];
+
+    if (route.active() && !terrain_.cell_at(route.frontier()).visited) {
+        return route.cells[route.next++];
+    }
+
+    route.clear();
+
+    auto neighbors = terrain_.available_neighbors(drone.position());
+
+    if (!neighbors.empty()) {
+        std::uniform_int_distribution<std::size_t> dist(
+            0,
+            neighbors.size() - 1
+        );
+
+        return neighbors[dist(seed_)];
+    }
+
+    if (recovery_ == StuckRecovery::SeekFrontier &&
+        search_.find_route(terrain_, drone.position(), route)) {
+        return route.cells[route.next++];
+    }
+
+    return std::nullopt;
+}
+
+
+SimulationStatus Simulation::run_until_done(StopToken stop,
+                                           Deadline deadline) {
     while (true) {
         if (target_found_) {
             return SimulationStatus::TargetFound;
         }
 
+        if (stop.stop_requested()) {
+            return SimulationStatus::Cancelled;
+        }
+
+        if (deadline.has_value() &&
+            std::chrono::steady_clock::now() >= deadline.value()) {
+            return SimulationStatus::DeadlineExceeded;
+        }
+
         const bool moved = step();
 
         if (target_found_) {
@@ -0,0 +1,218 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "aeroswarm/app/batch_runner.hpp"
+#include "aeroswarm/app/online_statistics.hpp"
+
+namespace {
+
+std::vector<std::string> split_lines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+
+    while (std::getline(stream, line)) {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+
+// run index -> row without the trailing wall_ms column.
+std::map<std::size_t, std::string> rows_by_run(const std::string& csv) {
+    std::map<std::size_t, std::string> rows;
+    const auto lines = split_lines(csv);
+
+    for (std::size_t i = 1; i < lines.size(); ++i) {
+        const auto& line = lines[i];
+        const std::size_t run = std::stoul(line.substr(0, line.find(',')));
+        rows[run] = line.substr(0, line.rfind(','));
+    }
+
+    return rows;
+}
+
+} // namespace
+
+
+TEST_CASE("RunningStatistics matches the two-pass formulas") {
+    RunningStatistics stats;
+
+    const std::vector<double> values{4.0, 7.0, 13.0, 16.0, 2.5};
+
+    for (const double value : values) {
+        stats.add(value);
+    }
+
+    const double mean =
+        std::accumulate(values.begin(), values.end(), 0.0) / 5.0;
+
+    double squares = 0.0;
+
+    for (const double value : values) {
+        squares += (value - mean) * (value - mean);
+    }
+
+    REQUIRE(stats.count() == 5);
+    REQUIRE(std::abs(stats.mean() - mean) < 1e-12);
+    REQUIRE(std::abs(stats.stddev() - std::sqrt(squares / 4.0)) < 1e-12);
+    REQUIRE(stats.min() == 2.5);
+    REQUIRE(stats.max() == 16.0);
+}
+
+
+TEST_CASE("P2Quantile tracks quantiles without storing values") {
+    std::vector<double> values(20000);
+    std::iota(values.begin(), values.end(), 1.0);
+
+    std::mt19937 rng(3);
+    std::shuffle(values.begin(), values.end(), rng);
+
+    P2Quantile p50{0.50};
+    P2Quantile p90{0.90};
+    P2Quantile p99{0.99};
+
+    for (const double value : values) {
+        p50.add(value);
+        p90.add(value);
+        p99.add(value);
+    }
+
+    REQUIRE(p50.count() == values.size());
+
+    // Within 1% of the range.
+    REQUIRE(std::abs(p50.value() - 10000.0) < 200.0);
+    REQUIRE(std::abs(p90.value() - 18000.0) < 200.0);
+    REQUIRE(std::abs(p99.value() - 19800.0) < 200.0);
+}
+
+
+TEST_CASE("P2Quantile is exact for the first values") {
+    P2Quantile median{0.5};
+
+    REQUIRE(median.value() == 0.0);
+
+    median.add(9.0);
+    median.add(1.0);
+    median.add(5.0);
+
+    REQUIRE(median.value() == 5.0);
+}
+
+
+TEST_CASE("run_batch streams one CSV row per run and summarizes") {
+    BatchConfig config;
+    config.map_sizes = {12, 16};
+    config.drone_counts = {1, 6};
+    config.seeds_per_config = 25;
+    config.worker_threads = 3;
+
+    std::ostringstream csv;
+    const auto summary = run_batch(config, &csv);
+
+    const auto lines = split_lines(csv.str());
+
+    REQUIRE(lines.front() == batch_csv_header());
+    REQUIRE(lines.size() == 1 + 4 * 25);
+    REQUIRE(rows_by_run(csv.str()).size() == 100);
+
+    REQUIRE(summary.configs.size() == 4);
+
+    for (const auto& entry : summary.configs) {
+        REQUIRE(entry.runs == 25);
+        REQUIRE(entry.target_found <= entry.runs);
+        REQUIRE(entry.ticks_to_target.count() == entry.target_found);
+        REQUIRE(entry.visited_cells.count() == 25);
+        REQUIRE(entry.visited_cells.min() >= 1.0);
+    }
+
+    REQUIRE(summary.configs[3].map_size == 16);
+    REQUIRE(summary.configs[3].drone_count == 6);
+}
+
+
+TEST_CASE("run_batch results do not depend on the pool size") {
+    for (const auto engine : {BatchEngine::Sequential, BatchEngine::Parallel}) {
+        BatchConfig config;
+        config.map_sizes = {14};
+        config.drone_counts = {3, 8};
+        config.seeds_per_config = 20;
+        config.engine = engine;
+
+        config.worker_threads = 1;
+        std::ostringstream single;
+        run_batch(config, &single);
+
+        config.worker_threads = 4;
+        std::ostringstream pooled;
+        run_batch(config, &pooled);
+
+        REQUIRE(rows_by_run(single.str()) == rows_by_run(pooled.str()));
+    }
+}
+
+
+TEST_CASE("run_batch reused sequential terrains run like fresh ones") {
+    BatchConfig config;
+    config.map_sizes = {12, 16};
+    config.drone_counts = {3};
+    config.seeds_per_config = 10;
+    config.recovery = StuckRecovery::SeekFrontier;
+
+    // One thread: every run after the first resets the previous terrain.
+    config.worker_threads = 1;
+    std::ostringstream reused;
+    run_batch(config, &reused);
+
+    const auto rows = rows_by_run(reused.str());
+
+    REQUIRE(rows.size() == 20);
+
+    for (const auto& [run, row] : rows) {
+        // A batch of one run starts on a fresh terrain.
+        BatchConfig single = config;
+        single.map_sizes = {config.map_sizes[run / 10]};
+        single.seeds_per_config = 1;
+        single.first_seed = config.first_seed + static_cast<unsigned int>(run % 10);
+
+        std::ostringstream fresh;
+        run_batch(single, &fresh);
+
+        const std::string fresh_row = rows_by_run(fresh.str()).at(0);
+
+        // Same row apart from the run index.
+        REQUIRE(row.substr(row.find(',')) ==
+                fresh_row.substr(fresh_row.find(',')));
+    }
+}
+
+
+TEST_CASE("run_batch frontier recovery finds the target more often") {
+    for (const auto engine : {BatchEngine::Sequential, BatchEngine::Parallel}) {
+        BatchConfig config;
+        config.map_sizes = {20};
+        config.drone_counts = {2};
+        config.seeds_per_config = 30;
+        config.engine = engine;
+        config.worker_threads = 2;
+
+        const auto stopping = run_batch(config, nullptr);
+
+        config.recovery = StuckRecovery::SeekFrontier;
+        const auto recovering = run_batch(config, nullptr);
+
+        REQUIRE(recovering.configs[0].target_found >
+                stopping.configs[0].target_found);
+        REQUIRE(recovering.configs[0].visited_cells.mean() >
+                stopping.configs[0].visited_cells.mean());
+    }
+}
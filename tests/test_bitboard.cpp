@@ -0,0 +1,218 @@
+#include <catch2/catch_test_macros.hpp>
+#include "aeroswarm/bitboard.hpp"
+#include "aeroswarm/neighborhood.hpp"
+#include "aeroswarm/parallel/terrain.hpp"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Per-cell reference: open (not blocked, in bounds) neighbors of (x, y)
+// among the window bits in `neighbors`.
+int reference_open_neighbors(const std::vector<bool>& blocked,
+                             int width,
+                             int height,
+                             int x,
+                             int y,
+                             std::uint32_t neighbors)
+{
+    int count = 0;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = x + dx;
+            const int ny = y + dy;
+
+            if (!((neighbors >> ((dy + 1) * 3 + (dx + 1))) & 1u) ||
+                nx < 0 || ny < 0 || nx >= width || ny >= height) {
+                continue;
+            }
+
+            if (!blocked[static_cast<std::size_t>(ny) * width + nx]) {
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+
+// Row y of `board` through count_open_neighbors(), indexed by x.
+std::vector<int> kernel_row(NeighborKernel kernel,
+                            const Bitboard& board,
+                            int y,
+                            std::uint32_t neighbors)
+{
+    const std::size_t stride = board.stride();
+
+    std::vector<std::uint64_t> rows(3 * (stride + 2), ~std::uint64_t{0});
+    std::vector<std::uint8_t> counts(stride * 64);
+
+    for (int r = 0; r < 3; ++r) {
+        board.copy_row(y + r, rows.data() + r * (stride + 2) + 1);
+    }
+
+    count_open_neighbors(
+        kernel,
+        rows.data() + 1,
+        rows.data() + (stride + 2) + 1,
+        rows.data() + 2 * (stride + 2) + 1,
+        stride,
+        neighbors,
+        counts.data()
+    );
+
+    std::vector<int> result;
+
+    for (int x = 0; x < board.width(); ++x) {
+        result.push_back(counts[static_cast<std::size_t>(x) + 1]);
+    }
+
+    return result;
+}
+
+} // namespace
+
+
+TEST_CASE("Bitboard set reports only the first writer") {
+    Bitboard board{5, 4, false};
+
+    REQUIRE_FALSE(board.test({2, 3}));
+    REQUIRE(board.set({2, 3}));
+    REQUIRE_FALSE(board.set({2, 3}));
+    REQUIRE(board.test({2, 3}));
+
+    board.clear({2, 3});
+    REQUIRE_FALSE(board.test({2, 3}));
+
+    board.store_exclusive({4, 0}, true);
+    REQUIRE(board.test({4, 0}));
+}
+
+
+TEST_CASE("Bitboard window reads the border and straddles words") {
+    // 63 + 2 padded columns: cell 62's east neighbor is in word 1.
+    for (const int width : {3, 62, 63, 64, 130}) {
+        Bitboard border{width, 3, true};
+
+        // Corner: the 5 outside neighbors are border bits.
+        REQUIRE(border.window({0, 0}) == 0b001'001'111u);
+        REQUIRE(border.window({width - 1, 2}) == 0b111'100'100u);
+
+        Bitboard board{width, 3, false};
+
+        board.set({width - 1, 1});
+        board.set({width - 2, 0});
+
+        // Bit (dy + 1) * 3 + (dx + 1) around (width - 2, 1).
+        REQUIRE(board.window({width - 2, 1}) == ((1u << 1) | (1u << 5)));
+    }
+}
+
+
+TEST_CASE("Neighbor lookup lists directions in table order") {
+    constexpr std::array<Position, 8> directions{{
+        {0, 1}, {0, -1}, {1, 0}, {-1, 0},
+        {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+    }};
+
+    constexpr NeighborLookup lookup = make_neighbor_lookup(directions);
+
+    for (std::size_t window = 0; window < lookup.size(); ++window) {
+        std::vector<std::uint8_t> expected;
+
+        for (std::size_t d = 0; d < directions.size(); ++d) {
+            const int bit = (directions[d].y + 1) * 3 + (directions[d].x + 1);
+
+            if ((window >> bit) & 1u) {
+                expected.push_back(static_cast<std::uint8_t>(d));
+            }
+        }
+
+        REQUIRE(lookup[window].count == expected.size());
+
+        for (std::size_t k = 0; k < expected.size(); ++k) {
+            REQUIRE(lookup[window].directions[k] == expected[k]);
+        }
+    }
+}
+
+
+TEST_CASE("Neighbor kernels match the per-cell count") {
+    std::mt19937 rng{7};
+
+    for (const int width : {1, 62, 63, 64, 130, 300}) {
+        const int height = 5;
+
+        Bitboard board{width, height, true};
+        std::vector<bool> blocked(static_cast<std::size_t>(width) * height);
+
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (rng() % 3 == 0) {
+                    board.set({x, y});
+                    blocked[static_cast<std::size_t>(y) * width + x] = true;
+                }
+            }
+        }
+
+        const std::uint32_t masks[] = {
+            neighbor_window_mask(EightConnected::directions),
+            neighbor_window_mask(FourConnected::directions),
+            neighbor_window_mask(HexOffset::directions),
+            neighbor_window_mask(HexOffset::odd_row_directions)
+        };
+
+        for (const std::uint32_t mask : masks) {
+            for (int y = 0; y < height; ++y) {
+                std::vector<int> expected;
+
+                for (int x = 0; x < width; ++x) {
+                    expected.push_back(reference_open_neighbors(
+                        blocked, width, height, x, y, mask
+                    ));
+                }
+
+                REQUIRE(kernel_row(NeighborKernel::Scalar, board, y, mask) ==
+                        expected);
+
+                if (neighbor_kernel_supported(NeighborKernel::Avx2)) {
+                    REQUIRE(kernel_row(NeighborKernel::Avx2, board, y, mask) ==
+                            expected);
+                }
+            }
+        }
+    }
+}
+
+
+TEST_CASE("ParallelTerrain neighbors keep the direction order") {
+    ParallelTerrain terrain{70, 4};
+
+    terrain.set_obstacle({63, 1});
+    REQUIRE(terrain.try_claim_cell({64, 2}));
+
+    // Every available direction of {0,1} {0,-1} {1,0} {-1,0}
+    // {1,1} {1,-1} {-1,1} {-1,-1}, in that order.
+    const auto neighbors = terrain.available_neighbors({64, 1});
+    const std::vector<Position> expected{
+        {64, 0}, {65, 1}, {65, 2}, {65, 0}, {63, 2}, {63, 0}
+    };
+
+    REQUIRE(neighbors.size() == expected.size());
+
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        REQUIRE(neighbors[i].x == expected[i].x);
+        REQUIRE(neighbors[i].y == expected[i].y);
+    }
+
+    // Gain built by the row kernel on a fresh terrain.
+    ParallelTerrain fresh{70, 4};
+    REQUIRE(fresh.information_gain({0, 0}) == 3);
+    REQUIRE(fresh.information_gain({63, 0}) == 5);
+    REQUIRE(fresh.information_gain({64, 2}) == 8);
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include "aeroswarm/live/density_pyramid.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+TEST_CASE("DensityPyramid sizes its levels to the map") {
+    DensityPyramid small{3, 2};
+
+    // 2 x 2 blocks only.
+    REQUIRE(small.level_count() == 1);
+    REQUIRE(small.level_width(1) == 2);
+    REQUIRE(small.level_height(1) == 1);
+
+    DensityPyramid large{1000, 300};
+
+    REQUIRE(large.level_count() == DensityPyramid::max_level);
+    REQUIRE(large.level_width(7) == 8);
+    REQUIRE(large.level_height(7) == 3);
+}
+
+
+TEST_CASE("DensityPyramid counts visits and obstacles on every level") {
+    DensityPyramid pyramid{16, 16};
+
+    REQUIRE(pyramid.level_count() == 3);
+
+    pyramid.set_obstacles({{0, 0}, {15, 15}});
+    pyramid.add_visited({5, 6});
+    pyramid.add_visited({4, 7});
+    pyramid.add_visited({-1, 2});
+
+    // (5, 6) and (4, 7) share the 2 x 2 block (2, 3) and the
+    // 8 x 8 block (0, 0).
+    REQUIRE(pyramid.visited_count(1, 2, 3) == 2);
+    REQUIRE(pyramid.visited_count(2, 1, 1) == 2);
+    REQUIRE(pyramid.visited_count(3, 0, 0) == 2);
+    REQUIRE(pyramid.obstacle_count(3, 0, 0) == 1);
+    REQUIRE(pyramid.obstacle_count(3, 1, 1) == 1);
+
+    pyramid.clear_visited();
+
+    REQUIRE(pyramid.visited_count(3, 0, 0) == 0);
+    REQUIRE(pyramid.obstacle_count(3, 0, 0) == 1);
+}
+
+
+TEST_CASE("DensityPyramid mixes block colors by coverage") {
+    DensityPyramid pyramid{5, 4};
+
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 2; ++x) {
+            pyramid.add_visited({x, y});
+        }
+    }
+
+    // Fully visited, untouched, and a half-visited edge block (the
+    // 5th column: one 1 x 2 block).
+    pyramid.add_visited({4, 0});
+
+    REQUIRE(pyramid.texel_at(1, 0, 0) == TexelGrid::visited_color);
+    REQUIRE(pyramid.texel_at(1, 1, 0) == TexelGrid::free_color);
+
+    const std::uint32_t half = pyramid.texel_at(1, 2, 0);
+
+    REQUIRE(half != TexelGrid::free_color);
+    REQUIRE(half != TexelGrid::visited_color);
+    REQUIRE((half & 0xffu) == 0xffu);
+
+    std::vector<std::uint32_t> pixels(3 * 2, 0);
+
+    pyramid.fill(
+        1, 0, 0, 3, 2,
+        pixels.data(),
+        3 * static_cast<int>(sizeof(std::uint32_t))
+    );
+
+    REQUIRE(pixels[0] == TexelGrid::visited_color);
+    REQUIRE(pixels[2] == half);
+    REQUIRE(pixels[3] == TexelGrid::free_color);
+}
+
+
+TEST_CASE("DensityPyramid version changes with every update") {
+    DensityPyramid pyramid{8, 8};
+
+    const auto start = pyramid.version();
+
+    pyramid.add_visited({1, 1});
+    REQUIRE(pyramid.version() != start);
+
+    const auto visited = pyramid.version();
+
+    pyramid.add_visited({8, 8});
+    REQUIRE(pyramid.version() == visited);
+}
@@ -0,0 +1,352 @@
+#include <catch2/catch_test_macros.hpp>
+#include "aeroswarm/live/bounded_queue.hpp"
+#include "aeroswarm/live/frame_recorder.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+SimulationSnapshot make_frame(std::size_t tick,
+                              std::size_t epoch_begin,
+                              std::vector<Position> visited,
+                              std::vector<Position> drones)
+{
+    SimulationSnapshot frame;
+    frame.tick = tick;
+    frame.visited_epoch_begin = epoch_begin;
+    frame.visited_epoch = epoch_begin + visited.size();
+    frame.visited_cells = std::move(visited);
+    frame.drone_positions = std::move(drones);
+    return frame;
+}
+
+
+// Counts frames and holds every write until `release` is set.
+struct GatedSink {
+    std::shared_ptr<std::atomic<bool>> release;
+    std::shared_ptr<std::vector<std::size_t>> ticks;
+
+    void write(const SimulationSnapshot& frame, FrameRaster&) {
+        while (!release->load()) {
+            std::this_thread::yield();
+        }
+
+        ticks->push_back(frame.tick);
+    }
+
+    void finish() {
+    }
+};
+
+
+struct FailingSink {
+    void write(const SimulationSnapshot&, FrameRaster&) {
+        throw std::runtime_error("disk full");
+    }
+
+    void finish() {
+    }
+};
+
+
+std::uint32_t rgb_at(const std::vector<std::uint8_t>& pixels,
+                     int image_width,
+                     int x,
+                     int y)
+{
+    const std::size_t offset =
+        (static_cast<std::size_t>(y) * image_width + x) * 3;
+
+    return (static_cast<std::uint32_t>(pixels[offset]) << 24) |
+           (static_cast<std::uint32_t>(pixels[offset + 1]) << 16) |
+           (static_cast<std::uint32_t>(pixels[offset + 2]) << 8) |
+           0xffu;
+}
+
+} // namespace
+
+
+TEST_CASE("BoundedQueue hands values over in order and drains after close") {
+    BoundedQueue<int> queue{2};
+
+    REQUIRE(queue.push(1));
+    REQUIRE(queue.push(2));
+    REQUIRE(queue.size() == 2);
+
+    queue.close();
+
+    REQUIRE_FALSE(queue.push(3));
+
+    int value = 0;
+
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 1);
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 2);
+    REQUIRE_FALSE(queue.pop(value));
+}
+
+
+TEST_CASE("BoundedQueue makes the producer wait while it is full") {
+    BoundedQueue<int> queue{1};
+
+    REQUIRE(queue.push(1));
+
+    std::atomic<bool> pushed{false};
+
+    std::thread producer([&]() {
+        queue.push(2);
+        pushed.store(true);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    REQUIRE_FALSE(pushed.load());
+
+    int value = 0;
+    REQUIRE(queue.pop(value));
+
+    producer.join();
+
+    REQUIRE(pushed.load());
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 2);
+}
+
+
+TEST_CASE("FrameRaster paints cells, the target and drones in the renderer colors") {
+    FrameRaster raster{3, 2, 5};
+
+    auto frame = make_frame(1, 0, {{1, 0}}, {{2, 1}});
+    frame.obstacle_positions =
+        std::make_shared<const std::vector<Position>>(
+            std::vector<Position>{{0, 1}}
+        );
+    frame.target = Position{2, 0};
+
+    raster.apply(frame);
+
+    REQUIRE(raster.image_width() == 15);
+    REQUIRE(raster.image_height() == 10);
+
+    const auto& pixels = raster.pixels();
+
+    REQUIRE(pixels.size() == 15 * 10 * 3);
+
+    REQUIRE(rgb_at(pixels, 15, 0, 0) == TexelGrid::free_color);
+    REQUIRE(rgb_at(pixels, 15, 7, 2) == TexelGrid::visited_color);
+    REQUIRE(rgb_at(pixels, 15, 2, 7) == TexelGrid::obstacle_color);
+    REQUIRE(rgb_at(pixels, 15, 12, 2) == 0xdc3c3cffu);
+
+    // Drone: inset by one pixel on each side of its 5 x 5 cell.
+    REQUIRE(rgb_at(pixels, 15, 12, 7) == 0x3ca0e6ffu);
+    REQUIRE(rgb_at(pixels, 15, 10, 5) == TexelGrid::free_color);
+
+    // Drones move: the old position is repainted from the base image.
+    raster.apply(make_frame(2, 1, {}, {{0, 0}}));
+
+    const auto& moved = raster.pixels();
+
+    REQUIRE(rgb_at(moved, 15, 12, 7) == TexelGrid::free_color);
+    REQUIRE(rgb_at(moved, 15, 2, 2) == 0x3ca0e6ffu);
+}
+
+
+TEST_CASE("StreamFrameSink output reads back frame by frame") {
+    std::stringstream stream;
+
+    auto obstacles =
+        std::make_shared<const std::vector<Position>>(
+            std::vector<Position>{{3, 3}, {0, 4}}
+        );
+
+    {
+        StreamFrameSink sink{stream, 5, 6};
+        FrameRaster raster{5, 6, 1};
+
+        auto first = make_frame(0, 0, {{0, 0}, {4, 5}}, {{4, 5}});
+        first.obstacle_positions = obstacles;
+        first.target = Position{2, 2};
+
+        auto second = make_frame(7, 2, {{1, 0}}, {{1, 0}});
+        second.obstacle_positions = obstacles;
+        second.target = Position{2, 2};
+        second.target_found = true;
+        second.winning_drone_id = 3;
+        second.winning_tick = 7;
+
+        sink.write(first, raster);
+        sink.write(second, raster);
+        sink.finish();
+    }
+
+    FrameStreamReader reader{stream};
+
+    REQUIRE(reader.width() == 5);
+    REQUIRE(reader.height() == 6);
+
+    SimulationSnapshot frame;
+
+    REQUIRE(reader.next(frame));
+    REQUIRE(frame.tick == 0);
+    REQUIRE(frame.visited_epoch_begin == 0);
+    REQUIRE(frame.visited_epoch == 2);
+    REQUIRE(frame.visited_cells == std::vector<Position>{{0, 0}, {4, 5}});
+    REQUIRE(frame.drone_positions == std::vector<Position>{{4, 5}});
+    REQUIRE(*frame.obstacle_positions == *obstacles);
+    REQUIRE(frame.target == Position{2, 2});
+    REQUIRE_FALSE(frame.target_found);
+
+    REQUIRE(reader.next(frame));
+    REQUIRE(frame.tick == 7);
+    REQUIRE(frame.visited_epoch_begin == 2);
+    REQUIRE(frame.visited_epoch == 3);
+    REQUIRE(frame.visited_cells == std::vector<Position>{{1, 0}});
+    REQUIRE(*frame.obstacle_positions == *obstacles);
+    REQUIRE(frame.target_found);
+    REQUIRE(frame.winning_drone_id == 3);
+    REQUIRE(frame.winning_tick == std::size_t{7});
+
+    REQUIRE_FALSE(reader.next(frame));
+}
+
+
+TEST_CASE("FrameStreamReader rejects a stream that is not a frame stream") {
+    std::stringstream stream{"P6\n1 1\n255\n"};
+
+    REQUIRE_THROWS_AS(FrameStreamReader{stream}, std::runtime_error);
+}
+
+
+TEST_CASE("FrameRecorder writes every queued frame in order on its own thread") {
+    auto release = std::make_shared<std::atomic<bool>>(false);
+    auto ticks = std::make_shared<std::vector<std::size_t>>();
+
+    FrameRecorder<GatedSink> recorder{4, 4, 1, GatedSink{release, ticks}, 2};
+
+    // The writer holds the first frame; two more fill the queue.
+    recorder.record(make_frame(0, 0, {{0, 0}}, {}));
+    recorder.record(make_frame(1, 1, {{1, 0}}, {}));
+    recorder.record(make_frame(2, 2, {{2, 0}}, {}));
+
+    REQUIRE(recorder.visited_epoch() == 3);
+    REQUIRE(recorder.frames_written() == 0);
+
+    release->store(true);
+    recorder.finish();
+
+    REQUIRE(recorder.frames_written() == 3);
+    REQUIRE(*ticks == std::vector<std::size_t>{0, 1, 2});
+}
+
+
+TEST_CASE("FrameRecorder drops a visited delta that skips ahead") {
+    std::stringstream stream;
+
+    {
+        FrameRecorder<StreamFrameSink> recorder{
+            4, 4, 1, StreamFrameSink{stream, 4, 4}
+        };
+
+        recorder.record(make_frame(0, 0, {{0, 0}}, {}));
+
+        // Starts at epoch 5, but the recorder is at 1.
+        recorder.record(make_frame(1, 5, {{3, 3}}, {}));
+        recorder.record(make_frame(2, 1, {{1, 1}}, {}));
+
+        recorder.finish();
+    }
+
+    FrameStreamReader reader{stream};
+    SimulationSnapshot frame;
+
+    REQUIRE(reader.next(frame));
+    REQUIRE(reader.next(frame));
+    REQUIRE(frame.visited_cells.empty());
+    REQUIRE(reader.next(frame));
+    REQUIRE(frame.visited_cells == std::vector<Position>{{1, 1}});
+}
+
+
+TEST_CASE("FrameRecorder reports the writer's error to the producer") {
+    FrameRecorder<FailingSink> recorder{2, 2, 1, FailingSink{}, 1};
+
+    recorder.record(make_frame(0, 0, {}, {}));
+
+    // The writer fails on the first frame and closes the queue; a
+    // later record() or finish() rethrows its error.
+    REQUIRE_THROWS_AS(
+        [&]() {
+            for (std::size_t tick = 1; tick < 1000; ++tick) {
+                recorder.record(make_frame(tick, 0, {}, {}));
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+
+            recorder.finish();
+        }(),
+        std::runtime_error
+    );
+}
+
+
+TEST_CASE("PpmFrameSink and PipeFrameSink write binary PPM and raw RGB frames") {
+    const auto directory =
+        std::filesystem::temp_directory_path() / "aeroswarm_test_frames";
+
+    std::filesystem::remove_all(directory);
+
+    FrameRaster raster{2, 1, 2};
+    raster.apply(make_frame(0, 0, {{0, 0}}, {}));
+
+    PpmFrameSink ppm{directory.string()};
+    ppm.write(SimulationSnapshot{}, raster);
+    ppm.write(SimulationSnapshot{}, raster);
+    ppm.finish();
+
+    std::ifstream image{directory / "frame_000001.ppm", std::ios::binary};
+    const std::string contents{
+        std::istreambuf_iterator<char>(image),
+        std::istreambuf_iterator<char>()
+    };
+
+    REQUIRE(contents.rfind("P6\n4 2\n255\n", 0) == 0);
+    REQUIRE(contents.size() == 11 + 4 * 2 * 3);
+
+    const auto raw = directory / "frames.rgb";
+
+    PipeFrameSink pipe{"cat > '" + raw.string() + "'"};
+    pipe.write(SimulationSnapshot{}, raster);
+    pipe.write(SimulationSnapshot{}, raster);
+    pipe.finish();
+
+    REQUIRE(std::filesystem::file_size(raw) == 2 * 4 * 2 * 3);
+
+    std::filesystem::remove_all(directory);
+}
+
+
+TEST_CASE("FrameRecorder reports an encoder that exits early") {
+    // `true` reads nothing and exits: writes fail with EPIPE.
+    FrameRecorder<PipeFrameSink> recorder{
+        256, 256, 4, PipeFrameSink{"true"}, 2
+    };
+
+    REQUIRE_THROWS_AS(
+        [&]() {
+            for (std::size_t tick = 0; tick < 16; ++tick) {
+                recorder.record(make_frame(tick, 0, {}, {}));
+            }
+
+            recorder.finish();
+        }(),
+        std::runtime_error
+    );
+}
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include "aeroswarm/frontier.hpp"
+#include "aeroswarm/parallel/terrain.hpp"
+#include "aeroswarm/sequential/terrain.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+
+TEST_CASE("FrontierSearch routes through visited cells to the nearest unvisited cell") {
+    Terrain terrain{6, 3};
+
+    // Columns 0..3 visited, (4, 0) an obstacle:
+    //
+    //     v v v v # .
+    //     v v v v . .
+    //     v v v v . .
+    for (int y = 0; y < 3; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            terrain.mark_visited({x, y});
+        }
+    }
+
+    terrain.set_obstacle({4, 0});
+
+    FrontierSearch search;
+    FrontierRoute route;
+
+    REQUIRE(search.find_route(terrain, {0, 0}, route));
+
+    // 5 moves, each to a 4-connected neighbor, ending on (4, 1).
+    const std::vector<Position> expected{
+        {1, 0}, {2, 0}, {3, 0}, {3, 1}, {4, 1}
+    };
+
+    REQUIRE(route.cells == expected);
+    REQUIRE(route.next == 0);
+    REQUIRE(route.frontier() == Position{4, 1});
+    REQUIRE_FALSE(terrain.cell_at(route.frontier()).visited);
+
+    for (std::size_t i = 0; i + 1 < route.cells.size(); ++i) {
+        REQUIRE(terrain.cell_at(route.cells[i]).visited);
+    }
+
+    // The buffers are reused: a second search from elsewhere is just
+    // as exact.
+    REQUIRE(search.find_route(terrain, {3, 2}, route));
+    REQUIRE(route.cells == std::vector<Position>{{4, 2}});
+}
+
+
+TEST_CASE("FrontierSearch reports when no unvisited cell is reachable") {
+    Terrain terrain{5, 5};
+
+    // A visited pocket walled in by obstacles; the rest stays free.
+    terrain.mark_visited({0, 0});
+    terrain.mark_visited({1, 0});
+    terrain.set_obstacle({2, 0});
+    terrain.set_obstacle({0, 1});
+    terrain.set_obstacle({1, 1});
+
+    FrontierSearch search;
+    FrontierRoute route;
+
+    REQUIRE_FALSE(search.find_route(terrain, {0, 0}, route));
+    REQUIRE_FALSE(route.active());
+
+    // Out of the pocket the frontier is one step away.
+    REQUIRE(search.find_route(terrain, {4, 4}, route));
+    REQUIRE(route.cells.size() == 1);
+}
+
+
+TEST_CASE("FrontierSearch follows the terrain's neighborhood") {
+    ParallelTerrain terrain{8, 8};
+
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            if (!(x == 7 && y == 7)) {
+                REQUIRE(terrain.try_claim_cell({x, y}));
+            }
+        }
+    }
+
+    FrontierSearch search;
+    FrontierRoute route;
+
+    // 8-connected: straight down the diagonal, 7 moves.
+    REQUIRE(search.find_route(terrain, {0, 0}, route));
+    REQUIRE(route.cells.size() == 7);
+    REQUIRE(route.frontier() == Position{7, 7});
+
+    for (std::size_t i = 1; i < route.cells.size(); ++i) {
+        REQUIRE(std::abs(route.cells[i].x - route.cells[i - 1].x) <= 1);
+        REQUIRE(std::abs(route.cells[i].y - route.cells[i - 1].y) <= 1);
+    }
+
+    // Many searches on the same object (generation stamps, no clear),
+    // past the point where the 16-bit stamps wrap around.
+    int wrong_routes = 0;
+
+    for (int i = 0; i < 70000; ++i) {
+        const Position start{i % 7, (i / 7) % 7};
+
+        if (!search.find_route(terrain, start, route) ||
+            !(route.frontier() == Position{7, 7}) ||
+            route.cells.size() != static_cast<std::size_t>(
+                7 - std::min(start.x, start.y))) {
+            ++wrong_routes;
+        }
+    }
+
+    REQUIRE(wrong_routes == 0);
+}
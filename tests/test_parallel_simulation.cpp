@@ -1,4 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "aeroswarm/parallel/simulation.hpp"
 
 TEST_CASE("ParallelSimulation initializes without a winner") {
@@ -181,4 +185,771 @@ TEST_CASE("ParallelSimulation terminates with many competing drones") {
 for i in {1..100}; do
     ctest --test-dir build --output-on-failure || break
 done
-*/
\ No newline at end of file
+*/
+
+TEST_CASE("ParallelSimulation snapshots share the static obstacle layer") {
+    ParallelTerrain terrain{5, 5};
+
+    terrain.set_target({4, 4});
+    terrain.set_obstacle({2, 2});
+    terrain.set_obstacle({3, 1});
+
+    ParallelSimulation simulation{
+        terrain,
+        {Drone{1, {0, 0}}},
+        42
+    };
+
+    const auto first = simulation.snapshot();
+    const auto second = simulation.snapshot();
+
+    REQUIRE(first.obstacle_positions);
+    REQUIRE(first.obstacle_positions == second.obstacle_positions);
+    REQUIRE(first.obstacle_positions->size() == 2);
+
+    REQUIRE(first.target.has_value());
+    REQUIRE(first.target.value() == Position{4, 4});
+}
+
+
+TEST_CASE("TripleBuffer hands over only the latest published value") {
+    TripleBuffer<int> buffer;
+
+    REQUIRE_FALSE(buffer.update());
+
+    buffer.write_buffer() = 1;
+    buffer.publish();
+    buffer.write_buffer() = 2;
+    buffer.publish();
+
+    REQUIRE(buffer.update());
+    REQUIRE(buffer.read_buffer() == 2);
+
+    // Nothing new: the consumer keeps its frame.
+    REQUIRE_FALSE(buffer.update());
+    REQUIRE(buffer.read_buffer() == 2);
+
+    buffer.write_buffer() = 3;
+    buffer.publish();
+
+    REQUIRE(buffer.update());
+    REQUIRE(buffer.read_buffer() == 3);
+}
+
+
+TEST_CASE("TripleBuffer consumer never sees a torn or older value") {
+    TripleBuffer<std::vector<int>> buffer;
+
+    constexpr int frames = 20000;
+    std::atomic<bool> done{false};
+
+    std::thread producer([&]() {
+        for (int frame = 1; frame <= frames; ++frame) {
+            auto& slot = buffer.write_buffer();
+            slot.assign(16, frame);
+            buffer.publish();
+        }
+
+        done.store(true);
+    });
+
+    int last = 0;
+    bool consistent = true;
+
+    const auto check = [&]() {
+        buffer.update();
+
+        const auto& slot = buffer.read_buffer();
+
+        if (slot.empty()) {
+            return;
+        }
+
+        for (const int value : slot) {
+            consistent = consistent && value == slot.front();
+        }
+
+        consistent = consistent && slot.front() >= last;
+        last = slot.front();
+    };
+
+    while (!done.load()) {
+        check();
+    }
+
+    producer.join();
+    check();
+
+    REQUIRE(consistent);
+    REQUIRE(buffer.read_buffer().front() == frames);
+}
+
+
+TEST_CASE("ParallelSimulation latest_snapshot falls back to snapshot") {
+    ParallelTerrain terrain{4, 4};
+    terrain.set_target({3, 3});
+
+    ParallelSimulation simulation{
+        terrain,
+        {Drone{1, {0, 0}}},
+        42
+    };
+
+    const auto latest = simulation.latest_snapshot();
+
+    REQUIRE(latest.drone_positions.size() == 1);
+    REQUIRE(latest.visited_epoch == 1);
+    REQUIRE(latest.visited_cells.size() == 1);
+}
+
+
+TEST_CASE("ParallelSimulation publishes snapshots while running") {
+    ParallelTerrain terrain{12, 12, TerrainSynchronization::LockFree};
+    terrain.set_target({11, 11});
+
+    std::vector<Drone> drones;
+
+    for (int id = 0; id < 4; ++id) {
+        drones.emplace_back(id, Position{0, id});
+    }
+
+    ParallelSimulationOptions options;
+    options.snapshot_interval = std::chrono::milliseconds{1};
+
+    ParallelSimulation simulation{
+        terrain,
+        drones,
+        42,
+        options
+    };
+
+    // The constructor publishes the start state.
+    const auto initial = simulation.latest_snapshot();
+    REQUIRE(initial.drone_positions.size() == 4);
+    REQUIRE(initial.visited_epoch == 4);
+    REQUIRE(initial.tick == 0);
+
+    std::atomic<bool> finished{false};
+
+    std::thread runner([&]() {
+        simulation.run();
+        finished.store(true);
+    });
+
+    // Accumulate deltas like the renderer does.
+    std::vector<Position> visited = initial.visited_cells;
+    std::size_t epoch = initial.visited_epoch;
+    bool contiguous = true;
+
+    while (!finished.load()) {
+        const auto frame = simulation.latest_snapshot(epoch);
+
+        contiguous = contiguous && frame.visited_epoch_begin == epoch;
+        contiguous = contiguous &&
+            frame.visited_cells.size() == frame.visited_epoch - epoch;
+
+        visited.insert(
+            visited.end(),
+            frame.visited_cells.begin(),
+            frame.visited_cells.end()
+        );
+
+        epoch = frame.visited_epoch;
+    }
+
+    runner.join();
+
+    // run() publishes a final frame after the workers are joined.
+    const auto last = simulation.latest_snapshot(epoch);
+    visited.insert(
+        visited.end(),
+        last.visited_cells.begin(),
+        last.visited_cells.end()
+    );
+
+    REQUIRE(contiguous);
+    REQUIRE(last.tick == simulation.snapshot().tick);
+    REQUIRE(last.target_found == simulation.target_found());
+    REQUIRE(last.winning_drone_id == simulation.winning_drone_id());
+    REQUIRE(last.visited_epoch == terrain.visited_count());
+    REQUIRE(visited == terrain.visited_positions());
+}
+
+
+TEST_CASE("WorkStealingQueues pops its own front and steals another's back") {
+    WorkStealingQueues queues{3};
+
+    queues.push(0, 10);
+    queues.push(0, 11);
+    queues.push(0, 12);
+
+    REQUIRE(queues.pop(0) == std::optional<std::size_t>{10});
+
+    REQUIRE_FALSE(queues.pop(2).has_value());
+    REQUIRE(queues.steal(2) == std::optional<std::size_t>{12});
+    REQUIRE(queues.steal(1) == std::optional<std::size_t>{11});
+
+    REQUIRE_FALSE(queues.steal(1).has_value());
+    REQUIRE_FALSE(queues.pop(0).has_value());
+}
+
+
+TEST_CASE("WorkStealingQueues idle threads sleep until a push or close") {
+    WorkStealingQueues queues{2};
+
+    std::atomic<int> woken{0};
+
+    std::thread waiter([&]() {
+        while (queues.wait_for_task()) {
+            if (queues.steal(1).has_value()) {
+                woken.fetch_add(1);
+            }
+        }
+    });
+
+    queues.push(0, 7);
+
+    while (woken.load() == 0) {
+        std::this_thread::yield();
+    }
+
+    queues.close();
+    waiter.join();
+
+    REQUIRE(woken.load() == 1);
+    REQUIRE_FALSE(queues.wait_for_task());
+}
+
+
+TEST_CASE("ParallelSimulation thread pool runs many drones on few threads") {
+    ParallelTerrain terrain{40, 40, TerrainSynchronization::LockFree};
+
+    // Walled-in target: every drone has to get stuck.
+    terrain.set_target({39, 39});
+    terrain.set_obstacle({38, 39});
+    terrain.set_obstacle({39, 38});
+    terrain.set_obstacle({38, 38});
+
+    std::vector<Drone> drones;
+
+    for (int id = 0; id < 500; ++id) {
+        drones.emplace_back(id, Position{id % 40, (id / 40) % 40});
+    }
+
+    ParallelSimulationOptions options;
+    options.execution = ParallelExecution::ThreadPool;
+    options.worker_threads = 3;
+
+    ParallelSimulation simulation{
+        terrain,
+        drones,
+        42,
+        options
+    };
+
+    REQUIRE(simulation.run() == ParallelSimulationStatus::Stuck);
+    REQUIRE_FALSE(simulation.winning_drone_id().has_value());
+
+    // Every drone ended boxed in, and every move claimed one new cell.
+    const auto snapshot = simulation.snapshot();
+
+    for (const auto& position : snapshot.drone_positions) {
+        REQUIRE(terrain.available_neighbors(position).empty());
+    }
+
+    REQUIRE(snapshot.tick + 500 == terrain.visited_count());
+}
+
+
+TEST_CASE("ParallelSimulation thread pool finds the target") {
+    for (const std::size_t threads : {1u, 2u, 8u}) {
+        ParallelTerrain terrain{20, 20};
+
+        terrain.set_target({19, 19});
+
+        std::vector<Drone> drones;
+
+        for (int id = 0; id < 50; ++id) {
+            drones.emplace_back(id, Position{0, 0});
+        }
+
+        ParallelSimulationOptions options;
+        options.execution = ParallelExecution::ThreadPool;
+        options.worker_threads = threads;
+
+        ParallelSimulation simulation{
+            terrain,
+            drones,
+            7,
+            options
+        };
+
+        const auto status = simulation.run();
+
+        if (status == ParallelSimulationStatus::TargetFound) {
+            REQUIRE(simulation.winning_drone_id().has_value());
+            REQUIRE(simulation.snapshot().drone_positions.size() == 50);
+        } else {
+            REQUIRE_FALSE(simulation.winning_drone_id().has_value());
+        }
+    }
+}
+
+
+namespace {
+
+struct LockstepResult {
+    ParallelSimulationStatus status;
+    std::optional<int> winner;
+    std::size_t tick;
+    std::vector<Position> drone_positions;
+    std::vector<Position> visited;
+};
+
+
+LockstepResult run_lockstep(std::size_t threads) {
+    ParallelTerrain terrain{24, 24, TerrainSynchronization::LockFree};
+
+    terrain.set_target({20, 17});
+    terrain.set_obstacle({10, 10});
+    terrain.set_obstacle({11, 10});
+    terrain.set_obstacle({12, 10});
+
+    std::vector<Drone> drones;
+
+    // Shared start cells: plenty of conflicts from the first round on.
+    for (int id = 0; id < 40; ++id) {
+        drones.emplace_back(id, Position{id % 4, id % 3});
+    }
+
+    ParallelSimulationOptions options;
+    options.execution = ParallelExecution::Lockstep;
+    options.worker_threads = threads;
+
+    ParallelSimulation simulation{
+        terrain,
+        drones,
+        1234,
+        options
+    };
+
+    LockstepResult result;
+    result.status = simulation.run();
+    result.winner = simulation.winning_drone_id();
+
+    const auto snapshot = simulation.snapshot();
+    result.tick = snapshot.tick;
+    result.drone_positions = snapshot.drone_positions;
+
+    // Journal order within a round is not part of the contract.
+    result.visited = terrain.visited_positions();
+    std::sort(
+        result.visited.begin(),
+        result.visited.end(),
+        [](const Position& a, const Position& b) {
+            return a.y != b.y ? a.y < b.y : a.x < b.x;
+        }
+    );
+
+    return result;
+}
+
+} // namespace
+
+
+TEST_CASE("ParallelSimulation lockstep is identical for any thread count") {
+    const auto reference = run_lockstep(1);
+
+    REQUIRE(reference.tick > 0);
+
+    for (const std::size_t threads : {2u, 3u, 8u}) {
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            const auto result = run_lockstep(threads);
+
+            REQUIRE(result.status == reference.status);
+            REQUIRE(result.winner == reference.winner);
+            REQUIRE(result.tick == reference.tick);
+            REQUIRE(result.drone_positions == reference.drone_positions);
+            REQUIRE(result.visited == reference.visited);
+        }
+    }
+}
+
+
+TEST_CASE("ParallelSimulation lockstep moves at most one drone per cell") {
+    ParallelTerrain terrain{3, 1};
+
+    terrain.set_target({2, 0});
+
+    // Both drones want {1, 0}: exactly one gets it in round one.
+    ParallelSimulationOptions options;
+    options.execution = ParallelExecution::Lockstep;
+    options.worker_threads = 2;
+
+    ParallelSimulation simulation{
+        terrain,
+        {Drone{1, {0, 0}}, Drone{2, {0, 0}}},
+        5,
+        options
+    };
+
+    REQUIRE(simulation.run() == ParallelSimulationStatus::TargetFound);
+    REQUIRE(simulation.winning_drone_id().has_value());
+
+    const auto snapshot = simulation.snapshot();
+
+    // Round 1: one drone to {1, 0}. Round 2: it reaches the target.
+    REQUIRE(snapshot.tick == 2);
+    REQUIRE(terrain.visited_count() == 3);
+
+    const bool one_left_behind =
+        snapshot.drone_positions[0] == Position{0, 0} ||
+        snapshot.drone_positions[1] == Position{0, 0};
+
+    REQUIRE(one_left_behind);
+}
+
+
+TEST_CASE("StopToken without a source never stops") {
+    StopToken token;
+    REQUIRE_FALSE(token.stop_requested());
+
+    StopSource source;
+    const StopToken linked = source.get_token();
+
+    REQUIRE_FALSE(linked.stop_requested());
+    source.request_stop();
+    REQUIRE(linked.stop_requested());
+    REQUIRE(source.stop_requested());
+}
+
+
+TEST_CASE("ParallelSimulation run returns Cancelled on a stop request") {
+    for (const auto execution : {ParallelExecution::ThreadPerDrone,
+                                 ParallelExecution::ThreadPool,
+                                 ParallelExecution::Lockstep}) {
+        ParallelTerrain terrain{200, 200, TerrainSynchronization::LockFree};
+        terrain.set_target({199, 199});
+
+        std::vector<Drone> drones;
+
+        for (int id = 0; id < 4; ++id) {
+            drones.emplace_back(id, Position{id, 0});
+        }
+
+        // Paced: without the stop request this would run for minutes.
+        ParallelSimulationOptions options;
+        options.update_interval = std::chrono::milliseconds{5};
+        options.execution = execution;
+        options.worker_threads = 2;
+
+        ParallelSimulation simulation{terrain, drones, 42, options};
+
+        StopSource stop_source;
+        ParallelSimulationStatus status{ParallelSimulationStatus::Stuck};
+
+        std::thread runner([&]() {
+            status = simulation.run(stop_source.get_token());
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{30});
+
+        const auto requested = std::chrono::steady_clock::now();
+        stop_source.request_stop();
+        runner.join();
+
+        const auto latency = std::chrono::steady_clock::now() - requested;
+
+        REQUIRE(status == ParallelSimulationStatus::Cancelled);
+        REQUIRE(latency < std::chrono::milliseconds{500});
+        REQUIRE_FALSE(simulation.winning_drone_id().has_value());
+    }
+}
+
+
+TEST_CASE("ParallelSimulation run returns DeadlineExceeded") {
+    for (const auto execution : {ParallelExecution::ThreadPerDrone,
+                                 ParallelExecution::ThreadPool,
+                                 ParallelExecution::Lockstep}) {
+        ParallelTerrain terrain{200, 200};
+        terrain.set_target({199, 199});
+
+        ParallelSimulationOptions options;
+        options.update_interval = std::chrono::milliseconds{5};
+        options.execution = execution;
+
+        ParallelSimulation simulation{
+            terrain,
+            {Drone{1, {0, 0}}, Drone{2, {0, 1}}},
+            42,
+            options
+        };
+
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+
+        REQUIRE(simulation.run({}, deadline) ==
+                ParallelSimulationStatus::DeadlineExceeded);
+        REQUIRE(std::chrono::steady_clock::now() - deadline <
+                std::chrono::milliseconds{500});
+    }
+}
+
+
+TEST_CASE("ParallelSimulation snapshots stay consistent while drones move") {
+    ParallelTerrain terrain{64, 64, TerrainSynchronization::LockFree};
+
+    // Walled-in target: drones explore until every one is stuck.
+    terrain.set_target({63, 63});
+    terrain.set_obstacle({62, 63});
+    terrain.set_obstacle({63, 62});
+    terrain.set_obstacle({62, 62});
+
+    std::vector<Drone> drones;
+
+    for (int id = 0; id < 64; ++id) {
+        drones.emplace_back(id, Position{id, id % 8});
+    }
+
+    ParallelSimulationOptions options;
+    options.execution = ParallelExecution::ThreadPool;
+    options.worker_threads = 4;
+
+    ParallelSimulation simulation{terrain, drones, 42, options};
+
+    std::atomic<bool> finished{false};
+
+    std::thread runner([&]() {
+        simulation.run();
+        finished.store(true);
+    });
+
+    bool consistent = true;
+    std::size_t snapshots = 0;
+
+    // Distinct starts and one fresh cell per move: in any real state no
+    // two drones share a cell.
+    while (!finished.load() || snapshots == 0) {
+        auto positions = simulation.snapshot().drone_positions;
+
+        std::sort(
+            positions.begin(),
+            positions.end(),
+            [](const Position& a, const Position& b) {
+                return a.y != b.y ? a.y < b.y : a.x < b.x;
+            }
+        );
+
+        consistent = consistent &&
+            positions.size() == 64 &&
+            std::adjacent_find(positions.begin(), positions.end()) ==
+                positions.end();
+
+        ++snapshots;
+    }
+
+    runner.join();
+
+    REQUIRE(consistent);
+
+    for (const auto& position : simulation.snapshot().drone_positions) {
+        REQUIRE(terrain.available_neighbors(position).empty());
+    }
+}
+
+
+TEST_CASE("ParallelSimulation elects exactly one winner under a crowd") {
+    struct Mode {
+        ParallelExecution execution;
+        std::size_t drones;
+    };
+
+    for (const auto mode : {Mode{ParallelExecution::ThreadPerDrone, 1000},
+                            Mode{ParallelExecution::ThreadPool, 4000},
+                            Mode{ParallelExecution::Lockstep, 4000}}) {
+        ParallelTerrain terrain{21, 21, TerrainSynchronization::LockFree};
+
+        const Position target{10, 10};
+        terrain.set_target(target);
+
+        // Every drone starts on one of the 8 cells around the target.
+        std::vector<Drone> drones;
+
+        for (std::size_t id = 0; id < mode.drones; ++id) {
+            const int ring = static_cast<int>(id % 8);
+            const Position offsets[8] = {
+                {-1, -1}, {0, -1}, {1, -1}, {-1, 0},
+                {1, 0}, {-1, 1}, {0, 1}, {1, 1}
+            };
+
+            drones.emplace_back(static_cast<int>(id), target + offsets[ring]);
+        }
+
+        ParallelSimulationOptions options;
+        options.execution = mode.execution;
+        options.worker_threads = 8;
+
+        ParallelSimulation simulation{terrain, drones, 42, options};
+
+        // A reader polling the winner the whole time: once a winner is
+        // visible it must never change.
+        std::atomic<bool> finished{false};
+        bool stable = true;
+
+        std::thread reader([&]() {
+            std::optional<int> seen;
+
+            while (!finished.load()) {
+                const auto snapshot = simulation.snapshot();
+
+                if (snapshot.target_found !=
+                    snapshot.winning_drone_id.has_value() ||
+                    snapshot.target_found !=
+                    snapshot.winning_tick.has_value()) {
+                    stable = false;
+                }
+
+                if (seen.has_value() &&
+                    snapshot.winning_drone_id != seen) {
+                    stable = false;
+                }
+
+                if (snapshot.winning_drone_id.has_value()) {
+                    seen = snapshot.winning_drone_id;
+                }
+            }
+        });
+
+        const auto status = simulation.run();
+
+        finished.store(true);
+        reader.join();
+
+        REQUIRE(status == ParallelSimulationStatus::TargetFound);
+        REQUIRE(stable);
+
+        const auto winner = simulation.winning_drone_id();
+        REQUIRE(winner.has_value());
+        REQUIRE(winner.value() >= 0);
+        REQUIRE(static_cast<std::size_t>(winner.value()) < mode.drones);
+
+        // Exactly one drone stands on the target.
+        const auto snapshot = simulation.snapshot();
+        std::size_t on_target = 0;
+
+        for (const auto& position : snapshot.drone_positions) {
+            if (position == target) {
+                ++on_target;
+            }
+        }
+
+        REQUIRE(on_target == 1);
+        REQUIRE(snapshot.drone_positions[winner.value()] == target);
+
+        REQUIRE(simulation.winning_tick().has_value());
+        REQUIRE(simulation.winning_tick().value() >= 1);
+        REQUIRE(simulation.winning_tick().value() <= snapshot.tick);
+    }
+}
+
+
+TEST_CASE("ParallelSimulation lockstep records the round of the win") {
+    ParallelTerrain terrain{5, 1};
+    terrain.set_target({4, 0});
+
+    ParallelSimulationOptions options;
+    options.execution = ParallelExecution::Lockstep;
+
+    ParallelSimulation simulation{
+        terrain,
+        {Drone{7, {0, 0}}},
+        1,
+        options
+    };
+
+    REQUIRE(simulation.run() == ParallelSimulationStatus::TargetFound);
+    REQUIRE(simulation.winning_drone_id() == std::optional<int>{7});
+    REQUIRE(simulation.winning_tick() == std::optional<std::size_t>{4});
+    REQUIRE(simulation.snapshot().winning_tick ==
+            std::optional<std::size_t>{4});
+}
+
+
+TEST_CASE("ParallelSimulation SeekFrontier routes boxed-in drones to the target") {
+    for (const auto execution : {ParallelExecution::ThreadPerDrone,
+                                 ParallelExecution::ThreadPool,
+                                 ParallelExecution::Lockstep}) {
+        for (const auto recovery : {StuckRecovery::Stop,
+                                    StuckRecovery::SeekFrontier}) {
+            ParallelTerrain terrain{16, 12, TerrainSynchronization::LockFree};
+
+            // Drones start in an already explored left half.
+            for (int y = 0; y < 12; ++y) {
+                for (int x = 0; x < 8; ++x) {
+                    REQUIRE(terrain.try_claim_cell({x, y}));
+                }
+            }
+
+            terrain.set_target({15, 11});
+
+            ParallelSimulationOptions options;
+            options.execution = execution;
+            options.worker_threads = 2;
+            options.recovery = recovery;
+
+            ParallelSimulation simulation{
+                terrain,
+                {Drone{1, {1, 1}}, Drone{2, {3, 9}}, Drone{3, {6, 5}}},
+                42,
+                options
+            };
+
+            const auto status = simulation.run();
+
+            if (recovery == StuckRecovery::Stop) {
+                REQUIRE(status == ParallelSimulationStatus::Stuck);
+                REQUIRE(terrain.visited_count() == 8 * 12);
+            } else {
+                REQUIRE(status == ParallelSimulationStatus::TargetFound);
+                REQUIRE(simulation.winning_drone_id().has_value());
+            }
+        }
+    }
+}
+
+
+TEST_CASE("ParallelSimulation SeekFrontier covers the map and stays deterministic in lockstep") {
+    const auto run = [](std::size_t worker_threads) {
+        ParallelTerrain terrain{20, 20, TerrainSynchronization::LockFree};
+
+        // Walled-in target: the run ends when nothing is left to visit.
+        terrain.set_target({19, 19});
+        terrain.set_obstacle({18, 19});
+        terrain.set_obstacle({19, 18});
+        terrain.set_obstacle({18, 18});
+
+        std::vector<Drone> drones;
+
+        for (int id = 0; id < 6; ++id) {
+            drones.emplace_back(id, Position{id * 3, id * 2});
+        }
+
+        ParallelSimulationOptions options;
+        options.execution = ParallelExecution::Lockstep;
+        options.worker_threads = worker_threads;
+        options.recovery = StuckRecovery::SeekFrontier;
+
+        ParallelSimulation simulation{terrain, drones, 9, options};
+
+        REQUIRE(simulation.run() == ParallelSimulationStatus::Stuck);
+        REQUIRE(terrain.visited_count() == 20 * 20 - 4);
+
+        return simulation.snapshot();
+    };
+
+    const auto one = run(1);
+    const auto three = run(3);
+
+    REQUIRE(one.tick == three.tick);
+    REQUIRE(one.drone_positions == three.drone_positions);
+}
@@ -1,10 +1,14 @@
 #include <catch2/catch_test_macros.hpp>
 #include "aeroswarm/parallel/simulation.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <random>
+#include <stdexcept>
+#include <utility>
 
 TEST_CASE("ParallelTerrain allows a cell to be claimed only once") {
     ParallelTerrain terrain{3,3};
@@ -350,6 +354,13 @@ TEST_CASE("ParallelTerrain information gain excludes obstacles") {
     REQUIRE(terrain.information_gain({1, 1}) == 6);
 }
 
+TEST_CASE("ParallelTerrain information gain rejects out-of-bounds positions") {
+    ParallelTerrain terrain{3, 3};
+
+    REQUIRE_THROWS_AS(terrain.information_gain({-1, 1}), std::out_of_range);
+    REQUIRE_THROWS_AS(terrain.information_gain({1, 3}), std::out_of_range);
+}
+
 
 TEST_CASE("ParallelTerrain corner has three available neighbors") {
     ParallelTerrain terrain{3, 3};
@@ -358,4 +369,622 @@ TEST_CASE("ParallelTerrain corner has three available neighbors") {
         terrain.available_neighbors({0, 0});
 
     REQUIRE(neighbors.size() == 3);
-}
\ No newline at end of file
+}
+
+TEST_CASE("ParallelTerrain stores one byte per cell") {
+    ParallelTerrain terrain{7, 5};
+
+    REQUIRE(terrain.storage_bytes() == 7 * 5);
+}
+
+
+TEST_CASE("ParallelTerrain keeps cells distinct on non-square maps") {
+    ParallelTerrain terrain{4, 2};
+
+    terrain.set_obstacle({3, 0});
+    terrain.set_target({0, 1});
+
+    REQUIRE(terrain.obstacle_positions().size() == 1);
+    REQUIRE(terrain.obstacle_positions()[0] == Position{3, 0});
+    REQUIRE(terrain.target_position().value() == Position{0, 1});
+
+    REQUIRE(terrain.try_claim_cell({0, 1}));
+    REQUIRE(terrain.visited_positions().size() == 1);
+    REQUIRE(terrain.visited_positions()[0] == Position{0, 1});
+}
+
+
+TEST_CASE("Lock-free ParallelTerrain allows a cell to be claimed only once") {
+    ParallelTerrain terrain{3, 3, TerrainSynchronization::LockFree};
+
+    REQUIRE(terrain.synchronization() == TerrainSynchronization::LockFree);
+
+    REQUIRE(terrain.try_claim_cell({1, 1}));
+    REQUIRE_FALSE(terrain.try_claim_cell({1, 1}));
+}
+
+
+TEST_CASE("Lock-free ParallelTerrain rejects obstacles and excludes them from neighbors") {
+    ParallelTerrain terrain{3, 3, TerrainSynchronization::LockFree};
+
+    terrain.set_obstacle({0, 1});
+    terrain.set_target({2, 2});
+
+    REQUIRE_FALSE(terrain.try_claim_cell({0, 1}));
+    REQUIRE(terrain.available_neighbors({1, 1}).size() == 7);
+    REQUIRE(terrain.information_gain({1, 1}) == 7);
+    REQUIRE(terrain.is_target({2, 2}));
+
+    REQUIRE(terrain.try_claim_cell({2, 2}));
+    REQUIRE(terrain.is_target({2, 2}));
+    REQUIRE(terrain.available_neighbors({1, 1}).size() == 6);
+}
+
+
+TEST_CASE("Lock-free ParallelTerrain allows exactly one thread to claim a cell") {
+    ParallelTerrain terrain{3, 3, TerrainSynchronization::LockFree};
+
+    std::atomic<int> successful_claims{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 32; ++i) {
+        threads.emplace_back([&terrain, &successful_claims, &go]() {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+
+            if (terrain.try_claim_cell({1, 1})) {
+                successful_claims.fetch_add(1);
+            }
+        });
+    }
+
+    go.store(true);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(successful_claims.load() == 1);
+}
+
+
+TEST_CASE("Lock-free ParallelTerrain gives every cell exactly one winner") {
+    ParallelTerrain terrain{16, 16, TerrainSynchronization::LockFree};
+
+    std::atomic<int> successful_claims{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&terrain, &successful_claims]() {
+            for (int y = 0; y < 16; ++y) {
+                for (int x = 0; x < 16; ++x) {
+                    if (terrain.try_claim_cell({x, y})) {
+                        successful_claims.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(successful_claims.load() == 16 * 16);
+    REQUIRE(terrain.visited_positions().size() == 16 * 16);
+}
+
+
+TEST_CASE("ParallelTerrain scored neighbors match the individual queries") {
+    ParallelTerrain terrain{4, 4};
+
+    terrain.set_target({2, 2});
+    terrain.set_obstacle({0, 1});
+    REQUIRE(terrain.try_claim_cell({2, 0}));
+
+    const auto neighbors = terrain.available_neighbors({1, 1});
+    const auto scored = terrain.scored_neighbors({1, 1});
+
+    REQUIRE(scored.size() == neighbors.size());
+
+    for (std::size_t i = 0; i < scored.size(); ++i) {
+        REQUIRE(scored[i].position == neighbors[i]);
+        REQUIRE(scored[i].is_target == terrain.is_target(neighbors[i]));
+        REQUIRE(
+            scored[i].information_gain ==
+            terrain.information_gain(neighbors[i])
+        );
+    }
+}
+
+
+TEST_CASE("ParallelTerrain scored neighbors are empty when boxed in") {
+    ParallelTerrain terrain{3, 3};
+
+    for (int y = 0; y < 3; ++y) {
+        for (int x = 0; x < 3; ++x) {
+            if (!(x == 1 && y == 1)) {
+                terrain.set_obstacle({x, y});
+            }
+        }
+    }
+
+    REQUIRE(terrain.scored_neighbors({1, 1}).empty());
+}
+
+
+namespace {
+
+// Full recomputation: available_neighbors() scans the neighborhood.
+template <typename TerrainType>
+bool gain_field_matches_scan(const TerrainType& terrain,
+                             int width,
+                             int height)
+{
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int scanned = static_cast<int>(
+                terrain.available_neighbors({x, y}).size()
+            );
+
+            if (terrain.information_gain({x, y}) != scanned) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+TEST_CASE("ParallelTerrain incremental information gain matches a full recomputation") {
+    ParallelTerrain terrain{9, 7};
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> x_dist(0, 8);
+    std::uniform_int_distribution<int> y_dist(0, 6);
+    std::uniform_int_distribution<int> op_dist(0, 4);
+
+    for (int step = 0; step < 200; ++step) {
+        const Position pos{x_dist(rng), y_dist(rng)};
+
+        switch (op_dist(rng)) {
+            case 0:
+                terrain.set_obstacle(pos);
+                break;
+            case 1:
+                terrain.set_target(pos);
+                break;
+            case 2:
+                terrain.initialize_start_position(pos);
+                break;
+            default:
+                terrain.try_claim_cell(pos);
+                break;
+        }
+
+        REQUIRE(gain_field_matches_scan(terrain, 9, 7));
+    }
+}
+
+
+TEST_CASE("Lock-free ParallelTerrain information gain is exact after concurrent claims") {
+    ParallelTerrain terrain{24, 24, TerrainSynchronization::LockFree};
+
+    for (int i = 0; i < 24; ++i) {
+        terrain.set_obstacle({i, (i * 7) % 24});
+    }
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&terrain, t]() {
+            std::mt19937 rng(static_cast<unsigned int>(t));
+            std::uniform_int_distribution<int> coord(0, 23);
+
+            for (int i = 0; i < 200; ++i) {
+                terrain.try_claim_cell({coord(rng), coord(rng)});
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(gain_field_matches_scan(terrain, 24, 24));
+}
+
+
+TEST_CASE("ParallelTerrain visited journal returns only cells since an epoch") {
+    ParallelTerrain terrain{4, 4};
+
+    REQUIRE(terrain.initialize_start_position({0, 0}));
+    REQUIRE(terrain.initialize_start_position({0, 0}));
+    REQUIRE(terrain.try_claim_cell({1, 0}));
+
+    std::vector<Position> first;
+    const std::size_t epoch = terrain.visited_since(0, first);
+
+    REQUIRE(epoch == 2);
+    REQUIRE(first == std::vector<Position>{{0, 0}, {1, 0}});
+
+    REQUIRE(terrain.try_claim_cell({2, 3}));
+    REQUIRE_FALSE(terrain.try_claim_cell({2, 3}));
+
+    std::vector<Position> delta;
+    const std::size_t next_epoch = terrain.visited_since(epoch, delta);
+
+    REQUIRE(next_epoch == 3);
+    REQUIRE(delta == std::vector<Position>{{2, 3}});
+    REQUIRE(terrain.visited_count() == 3);
+}
+
+
+TEST_CASE("Lock-free ParallelTerrain journal holds every concurrent claim once") {
+    ParallelTerrain terrain{16, 16, TerrainSynchronization::LockFree};
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&terrain]() {
+            for (int y = 0; y < 16; ++y) {
+                for (int x = 0; x < 16; ++x) {
+                    terrain.try_claim_cell({x, y});
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto visited = terrain.visited_positions();
+
+    REQUIRE(visited.size() == 16 * 16);
+
+    std::vector<int> seen(16 * 16, 0);
+
+    for (const auto& pos : visited) {
+        ++seen[pos.y * 16 + pos.x];
+    }
+
+    for (const int count : seen) {
+        REQUIRE(count == 1);
+    }
+}
+
+
+TEST_CASE("ParallelTerrain reset_visited restores an unvisited terrain") {
+    ParallelTerrain terrain{6, 5, TerrainSynchronization::LockFree};
+
+    terrain.set_target({5, 4});
+    terrain.set_obstacle({2, 2});
+
+    REQUIRE(terrain.initialize_start_position({0, 0}));
+    REQUIRE(terrain.try_claim_cell({1, 1}));
+    REQUIRE(terrain.try_claim_cell({5, 4}));
+    REQUIRE(terrain.visited_count() == 3);
+
+    terrain.reset_visited();
+
+    REQUIRE(terrain.visited_count() == 0);
+    REQUIRE(terrain.visited_positions().empty());
+    REQUIRE(gain_field_matches_scan(terrain, 6, 5));
+    REQUIRE(terrain.information_gain({1, 1}) == 7);
+
+    REQUIRE(terrain.is_target({5, 4}));
+    REQUIRE(terrain.obstacle_positions() == std::vector<Position>{{2, 2}});
+
+    REQUIRE(terrain.try_claim_cell({1, 1}));
+    REQUIRE_FALSE(terrain.try_claim_cell({2, 2}));
+
+    std::vector<Position> delta;
+    REQUIRE(terrain.visited_since(0, delta) == 1);
+    REQUIRE(delta == std::vector<Position>{{1, 1}});
+}
+
+
+TEST_CASE("ParallelTerrain set_obstacles replaces the obstacle layer") {
+    ParallelTerrain terrain{5, 5};
+
+    terrain.set_target({4, 4});
+    terrain.set_obstacles({{1, 1}, {3, 0}});
+
+    REQUIRE(terrain.obstacle_positions() ==
+            std::vector<Position>{{1, 1}, {3, 0}});
+
+    terrain.set_target({0, 4});
+    terrain.set_obstacles({{2, 3}, {0, 2}, {2, 3}});
+
+    REQUIRE(terrain.obstacle_positions() ==
+            std::vector<Position>{{2, 3}, {0, 2}});
+
+    REQUIRE(terrain.try_claim_cell({1, 1}));
+    REQUIRE_FALSE(terrain.try_claim_cell({2, 3}));
+
+    REQUIRE(terrain.is_target({0, 4}));
+    REQUIRE_FALSE(terrain.is_target({4, 4}));
+    REQUIRE(terrain.target_position().value() == Position{0, 4});
+
+    REQUIRE(gain_field_matches_scan(terrain, 5, 5));
+
+    REQUIRE_THROWS_AS(
+        terrain.set_obstacles({{0, 0}, {5, 0}}),
+        std::out_of_range
+    );
+
+    // Nothing was written: (0, 0) is still free.
+    REQUIRE(terrain.try_claim_cell({0, 0}));
+}
+
+
+TEST_CASE("Reused ParallelTerrain runs like a freshly built one") {
+    const std::vector<Position> obstacles{{3, 3}, {4, 3}, {5, 3}, {3, 7}};
+
+    const auto run = [&](ParallelTerrain& terrain) {
+        ParallelSimulationOptions options;
+        options.execution = ParallelExecution::Lockstep;
+        options.worker_threads = 1;
+
+        std::vector<Drone> drones{
+            Drone{0, {0, 0}}, Drone{1, {9, 0}},
+            Drone{2, {0, 9}}, Drone{3, {9, 9}}
+        };
+
+        ParallelSimulation simulation{terrain, drones, 5, options};
+        simulation.run();
+
+        return std::make_pair(
+            simulation.winning_drone_id(),
+            terrain.visited_positions()
+        );
+    };
+
+    ParallelTerrain fresh{10, 10, TerrainSynchronization::LockFree};
+    fresh.set_target({6, 6});
+    fresh.set_obstacles(obstacles);
+
+    ParallelTerrain reused{10, 10, TerrainSynchronization::LockFree};
+    reused.set_target({1, 8});
+    reused.set_obstacles({{6, 6}, {2, 2}, {7, 1}});
+    run(reused);
+
+    reused.reset_visited();
+    reused.set_target({6, 6});
+    reused.set_obstacles(obstacles);
+
+    REQUIRE(gain_field_matches_scan(reused, 10, 10));
+    REQUIRE(run(reused) == run(fresh));
+}
+
+
+namespace {
+
+// Brute-force count of the available neighbors of pos.
+template <typename Neighborhood>
+int counted_gain(const BasicParallelTerrain<Neighborhood>& terrain,
+                 const std::vector<Position>& blocked,
+                 const Position& pos)
+{
+    int available = 0;
+
+    for (const auto& dir : row_directions<Neighborhood>(pos.y)) {
+        const Position next = pos + dir;
+
+        if (terrain.in_bounds(next) &&
+            std::find(blocked.begin(), blocked.end(), next) == blocked.end()) {
+            ++available;
+        }
+    }
+
+    return available;
+}
+
+
+template <typename Neighborhood>
+void check_neighborhood() {
+    BasicParallelTerrain<Neighborhood> terrain{
+        6, 5, TerrainSynchronization::LockFree
+    };
+
+    terrain.set_obstacles({{2, 1}, {0, 4}});
+    REQUIRE(terrain.try_claim_cell({1, 2}));
+    REQUIRE(terrain.try_claim_cell({3, 3}));
+
+    const std::vector<Position> blocked{{2, 1}, {0, 4}, {1, 2}, {3, 3}};
+
+    for (int y = 0; y < 5; ++y) {
+        for (int x = 0; x < 6; ++x) {
+            const int expected = counted_gain(terrain, blocked, {x, y});
+
+            REQUIRE(terrain.information_gain({x, y}) == expected);
+            REQUIRE(static_cast<int>(
+                        terrain.available_neighbors({x, y}).size()) == expected);
+            REQUIRE(static_cast<int>(
+                        terrain.scored_neighbors({x, y}).size()) == expected);
+        }
+    }
+
+    // Setup-only paths give back exactly a fresh terrain's gain.
+    terrain.reset_visited();
+    terrain.set_obstacles({});
+
+    BasicParallelTerrain<Neighborhood> fresh{6, 5};
+
+    for (int y = 0; y < 5; ++y) {
+        for (int x = 0; x < 6; ++x) {
+            REQUIRE(terrain.information_gain({x, y}) ==
+                    fresh.information_gain({x, y}));
+        }
+    }
+}
+
+} // namespace
+
+
+TEST_CASE("ParallelTerrain can be built on every neighborhood") {
+    check_neighborhood<FourConnected>();
+    check_neighborhood<EightConnected>();
+    check_neighborhood<HexOffset>();
+
+    static_assert(
+        sizeof(BasicParallelTerrain<FourConnected>::NeighborList) <
+        sizeof(Neighbors),
+        "the neighbor list is sized by the policy"
+    );
+
+    // Center of an even row: the hex diagonals lean west.
+    BasicParallelTerrain<HexOffset> hex{3, 3};
+    const auto neighbors = hex.available_neighbors({1, 2});
+
+    REQUIRE(neighbors.size() == 4);
+    REQUIRE(neighbors[0] == Position{2, 2});
+    REQUIRE(neighbors[1] == Position{0, 2});
+    REQUIRE(neighbors[2] == Position{0, 1});
+    REQUIRE(neighbors[3] == Position{1, 1});
+}
+
+
+namespace {
+
+// 8 threads claim every cell of one terrain while querying neighbors.
+template <typename LockPolicy>
+void check_lock_policy(typename LockPolicy::Options options = {}) {
+    BasicTerrain<LockPolicy, AtomicStorage> terrain{20, 18, options};
+
+    for (int i = 0; i < 20; ++i) {
+        terrain.set_obstacle({i, (i * 5) % 18});
+    }
+
+    const std::size_t obstacles = terrain.obstacle_positions().size();
+
+    std::atomic<std::size_t> successful_claims{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&terrain, &successful_claims, t]() {
+            std::vector<Position> cells;
+
+            for (int y = 0; y < 18; ++y) {
+                for (int x = 0; x < 20; ++x) {
+                    cells.push_back({x, y});
+                }
+            }
+
+            std::mt19937 rng(static_cast<unsigned int>(t));
+            std::shuffle(cells.begin(), cells.end(), rng);
+
+            for (const auto& pos : cells) {
+                terrain.scored_neighbors(pos);
+
+                if (terrain.try_claim_cell(pos)) {
+                    successful_claims.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(successful_claims.load() == 20 * 18 - obstacles);
+    REQUIRE(terrain.visited_count() == 20 * 18 - obstacles);
+    REQUIRE(gain_field_matches_scan(terrain, 20, 18));
+}
+
+} // namespace
+
+
+TEST_CASE("Every lock policy gives every cell exactly one winner") {
+    check_lock_policy<GlobalMutexLock>();
+    check_lock_policy<StripedLock>();
+    check_lock_policy<StripedLock>(StripedLock::Options{1});
+    check_lock_policy<TiledLock>();
+    check_lock_policy<TiledLock>(TiledLock::Options{4});
+    check_lock_policy<AtomicCellsLock>();
+    check_lock_policy<SelectableLock>(TerrainSynchronization::Tiled);
+}
+
+
+TEST_CASE("StripedLock covers the rows of a region in order") {
+    StripedLock lock{10, 10, StripedLock::Options{4}};
+
+    REQUIRE(lock.stripe_count() == 3);
+
+    // Rows 3..5 span stripes 0 and 1; the guard releases them, so the
+    // next region (and all()) can take them again.
+    {
+        const auto guard = lock.region({0, 4});
+    }
+
+    {
+        const auto guard = lock.all();
+    }
+
+    // Border rows are clamped to the terrain.
+    const auto top = lock.region({0, 0});
+    const auto bottom = lock.region({0, 9});
+}
+
+
+TEST_CASE("TiledLock regions at tile corners do not deadlock") {
+    TiledLock lock{12, 12, TiledLock::Options{4}};
+
+    REQUIRE(lock.tile_count() == 9);
+
+    // Every thread walks the tile corners in a different order, so
+    // without one global acquisition order two of them would end up
+    // waiting on each other.
+    const std::vector<Position> corners{
+        {3, 3}, {4, 4}, {7, 3}, {8, 4}, {3, 7}, {4, 8}, {7, 7}, {8, 8}
+    };
+
+    std::atomic<int> regions{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&lock, &corners, &regions, t]() {
+            std::vector<Position> order = corners;
+            std::mt19937 rng(static_cast<unsigned int>(t));
+
+            for (int round = 0; round < 500; ++round) {
+                std::shuffle(order.begin(), order.end(), rng);
+
+                for (const auto& pos : order) {
+                    const auto guard = lock.region(pos);
+                    regions.fetch_add(1);
+                }
+
+                if (round % 100 == 0) {
+                    const auto guard = lock.all();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(regions.load() == 4 * 500 * 8);
+}
+
+
+TEST_CASE("Tiled ParallelTerrain keeps its mode") {
+    ParallelTerrain terrain{70, 40, TerrainSynchronization::Tiled};
+
+    REQUIRE(terrain.synchronization() == TerrainSynchronization::Tiled);
+
+    // (31, 31) and (32, 32) straddle the corner of four tiles.
+    REQUIRE(terrain.try_claim_cell({31, 31}));
+    REQUIRE_FALSE(terrain.try_claim_cell({31, 31}));
+    REQUIRE(terrain.information_gain({32, 32}) == 7);
+    REQUIRE(terrain.available_neighbors({32, 32}).size() == 7);
+}
@@ -28,4 +28,28 @@ TEST_CASE("Scenario factory is deterministic for the same seed") {
 
     REQUIRE(a.target == b.target);
     REQUIRE(a.obstacles == b.obstacles);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Scenario factory places extra drones on free cells") {
+    const auto scenario =
+        make_random_scenario(20, 20, 30, 7, 12);
+
+    REQUIRE(scenario.drones.size() == 12);
+    REQUIRE(scenario.drones[3].position() == Position{19, 19});
+
+    for (std::size_t i = 0; i < scenario.drones.size(); ++i) {
+        const auto& drone = scenario.drones[i];
+
+        REQUIRE(drone.id() == static_cast<int>(i) + 1);
+        REQUIRE_FALSE(drone.position() == scenario.target);
+
+        for (const auto& obstacle : scenario.obstacles) {
+            REQUIRE_FALSE(drone.position() == obstacle);
+        }
+    }
+
+    // The four-drone overload is unchanged.
+    const auto four = make_random_scenario(20, 20, 30, 7);
+    REQUIRE(four.drones.size() == 4);
+    REQUIRE(four.target == scenario.target);
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
-
+#include <thread>
+#include <vector>
 
 #include "aeroswarm/sequential/simulation.hpp"
 
@@ -238,7 +239,8 @@ TEST_CASE("Sequential snapshot contains obstacles") {
 
     const auto snapshot = simulation.snapshot();
 
-    REQUIRE(snapshot.obstacle_positions.size() == 2);
+    REQUIRE(snapshot.obstacle_positions);
+    REQUIRE(snapshot.obstacle_positions->size() == 2);
 }
 
 
@@ -258,4 +260,190 @@ TEST_CASE("Sequential snapshot contains target position") {
 
     REQUIRE(snapshot.target.has_value());
     REQUIRE(snapshot.target.value() == Position{2, 2});
-}
\ No newline at end of file
+}
+
+TEST_CASE("Sequential snapshot delivers visited cells incrementally") {
+    Terrain terrain{3, 3};
+
+    Simulation simulation{
+        terrain,
+        {Drone{1, {1, 1}}},
+        42
+    };
+
+    const auto first = simulation.snapshot();
+
+    REQUIRE(first.visited_epoch_begin == 0);
+    REQUIRE(first.visited_epoch == 1);
+    REQUIRE(first.visited_cells.size() == 1);
+
+    simulation.step();
+
+    const auto delta = simulation.snapshot(first.visited_epoch);
+
+    REQUIRE(delta.visited_epoch_begin == 1);
+    REQUIRE(delta.visited_epoch == 2);
+    REQUIRE(delta.visited_cells.size() == 1);
+    REQUIRE(delta.visited_cells[0] == simulation.drones()[0].position());
+
+    // The full list is still available on request.
+    REQUIRE(simulation.snapshot().visited_cells.size() == 2);
+}
+
+
+TEST_CASE("Sequential run_until_done honours a stop request") {
+    Terrain terrain{10, 10};
+    terrain.set_target({9, 9});
+
+    Simulation simulation{
+        terrain,
+        {Drone{1, {0, 0}}},
+        42
+    };
+
+    StopSource stop_source;
+    stop_source.request_stop();
+
+    REQUIRE(simulation.run_until_done(stop_source.get_token()) ==
+            SimulationStatus::Cancelled);
+    REQUIRE(simulation.snapshot().tick == 0);
+}
+
+
+TEST_CASE("Sequential run_until_done stops at the deadline") {
+    Terrain terrain{10, 10};
+    terrain.set_target({9, 9});
+
+    Simulation simulation{
+        terrain,
+        {Drone{1, {0, 0}}},
+        42
+    };
+
+    const Deadline expired = std::chrono::steady_clock::now();
+
+    REQUIRE(simulation.run_until_done({}, expired) ==
+            SimulationStatus::DeadlineExceeded);
+    REQUIRE_FALSE(simulation.target_found());
+}
+
+
+TEST_CASE("Sequential snapshot records the tick of the win") {
+    Terrain terrain{3, 1};
+    terrain.set_target({2, 0});
+
+    Simulation simulation{
+        terrain,
+        {Drone{4, {0, 0}}},
+        42
+    };
+
+    REQUIRE_FALSE(simulation.snapshot().winning_tick.has_value());
+
+    REQUIRE(simulation.run_until_done() == SimulationStatus::TargetFound);
+
+    const auto snapshot = simulation.snapshot();
+
+    REQUIRE(snapshot.winning_drone_id == std::optional<int>{4});
+    REQUIRE(snapshot.winning_tick == std::optional<std::size_t>{2});
+}
+
+
+TEST_CASE("Concurrent simulations share one static terrain layer") {
+    Terrain base{20, 20};
+
+    base.set_target({17, 13});
+
+    for (int i = 2; i < 18; ++i) {
+        base.set_obstacle({i, 9});
+    }
+
+    const std::vector<Drone> drones{
+        Drone{0, {0, 0}}, Drone{1, {19, 0}},
+        Drone{2, {0, 19}}, Drone{3, {19, 19}}
+    };
+
+    Simulation reference{base, drones, 9};
+    const auto expected = reference.run_until_done();
+
+    constexpr int runs = 8;
+
+    std::vector<SimulationStatus> statuses(runs);
+    std::vector<std::size_t> ticks(runs);
+    std::vector<int> shared(runs);
+    std::vector<std::thread> threads;
+
+    for (int r = 0; r < runs; ++r) {
+        threads.emplace_back([&, r]() {
+            Simulation simulation{base, drones, 9};
+
+            statuses[r] = simulation.run_until_done();
+            ticks[r] = simulation.tick();
+            shared[r] =
+                simulation.terrain().static_layer() == base.static_layer();
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int r = 0; r < runs; ++r) {
+        REQUIRE(statuses[r] == expected);
+        REQUIRE(ticks[r] == reference.tick());
+        REQUIRE(shared[r]);
+    }
+
+    REQUIRE(base.visited_count() == 0);
+}
+
+
+TEST_CASE("Sequential SeekFrontier routes a boxed-in drone to the rest of the map") {
+    // The left half is already explored; the drone starts inside it.
+    Terrain terrain{8, 4};
+
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            terrain.mark_visited({x, y});
+        }
+    }
+
+    terrain.set_target({7, 3});
+
+    Simulation stopping{terrain, {Drone{1, {1, 1}}}, 42};
+
+    REQUIRE(stopping.run_until_done() == SimulationStatus::Stuck);
+    REQUIRE(stopping.tick() == 1);
+    REQUIRE(stopping.terrain().visited_count() == 16);
+
+    Simulation recovering{
+        terrain,
+        {Drone{1, {1, 1}}},
+        42,
+        StuckRecovery::SeekFrontier
+    };
+
+    REQUIRE(recovering.run_until_done() == SimulationStatus::TargetFound);
+    REQUIRE(recovering.winning_drone_id() == std::optional<int>{1});
+}
+
+
+TEST_CASE("Sequential SeekFrontier covers every reachable cell") {
+    Terrain terrain{9, 7};
+
+    terrain.set_obstacle({4, 0});
+    terrain.set_obstacle({4, 1});
+    terrain.set_obstacle({4, 2});
+    terrain.set_obstacle({4, 4});
+
+    std::vector<Drone> drones{
+        Drone{1, {0, 0}},
+        Drone{2, {8, 6}},
+        Drone{3, {2, 3}}
+    };
+
+    Simulation simulation{terrain, drones, 7, StuckRecovery::SeekFrontier};
+
+    REQUIRE(simulation.run_until_done() == SimulationStatus::Stuck);
+    REQUIRE(simulation.terrain().visited_count() == 9 * 7 - 4);
+}
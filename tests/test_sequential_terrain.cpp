@@ -1,8 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include "aeroswarm/sequential/terrain.hpp"
+#include "aeroswarm/bitboard.hpp"
 
 #include <stdexcept>
 #include <algorithm>
+#include <random>
 
 TEST_CASE("Terrain reports valid bounds") {
     Terrain terrain{3, 4};
@@ -111,4 +113,266 @@ TEST_CASE("Terrain reports visited positions") {
     const auto visited = terrain.visited_positions();
 
     REQUIRE(visited.size() == 2);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Terrain stores one byte per cell") {
+    Terrain terrain{7, 5};
+
+    REQUIRE(terrain.storage_bytes() == 7 * 5);
+}
+
+
+TEST_CASE("Terrain keeps cells distinct on non-square maps") {
+    Terrain terrain{4, 2};
+
+    terrain.set_obstacle({3, 0});
+    terrain.mark_visited({0, 1});
+
+    REQUIRE(terrain.cell_at({3, 0}).type == CellType::Obstacle);
+    REQUIRE_FALSE(terrain.cell_at({3, 0}).visited);
+    REQUIRE(terrain.cell_at({0, 1}).visited);
+    REQUIRE(terrain.cell_at({0, 1}).type == CellType::Free);
+    REQUIRE(terrain.cell_at({1, 0}).type == CellType::Free);
+    REQUIRE_FALSE(terrain.cell_at({1, 0}).visited);
+}
+
+
+TEST_CASE("Terrain reports information gain") {
+    Terrain terrain{3, 3};
+
+    REQUIRE(terrain.information_gain({1, 1}) == 4);
+    REQUIRE(terrain.information_gain({0, 0}) == 2);
+
+    terrain.mark_visited({1, 0});
+    terrain.set_obstacle({0, 1});
+
+    REQUIRE(terrain.information_gain({1, 1}) == 2);
+    REQUIRE(terrain.information_gain({0, 0}) == 0);
+}
+
+
+TEST_CASE("Terrain incremental information gain matches a full recomputation") {
+    Terrain terrain{9, 7};
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> x_dist(0, 8);
+    std::uniform_int_distribution<int> y_dist(0, 6);
+    std::uniform_int_distribution<int> op_dist(0, 3);
+
+    for (int step = 0; step < 200; ++step) {
+        const Position pos{x_dist(rng), y_dist(rng)};
+
+        switch (op_dist(rng)) {
+            case 0:
+                terrain.set_obstacle(pos);
+                break;
+            case 1:
+                terrain.set_target(pos);
+                break;
+            default:
+                terrain.mark_visited(pos);
+                break;
+        }
+
+        for (int y = 0; y < 7; ++y) {
+            for (int x = 0; x < 9; ++x) {
+                REQUIRE(
+                    terrain.information_gain({x, y}) ==
+                    static_cast<int>(
+                        terrain.available_neighbors({x, y}).size()
+                    )
+                );
+            }
+        }
+    }
+}
+
+
+TEST_CASE("Terrain records its target and caches the obstacle list") {
+    Terrain terrain{4, 4};
+
+    REQUIRE_FALSE(terrain.target_position().has_value());
+
+    terrain.set_target({3, 1});
+    terrain.set_obstacle({0, 2});
+
+    REQUIRE(terrain.target_position().value() == Position{3, 1});
+
+    const auto first = terrain.shared_obstacle_positions();
+    const auto second = terrain.shared_obstacle_positions();
+
+    REQUIRE(first == second);
+    REQUIRE(first->size() == 1);
+
+    // A new obstacle replaces the cached list, the old one is untouched.
+    terrain.set_obstacle({3, 1});
+
+    const auto third = terrain.shared_obstacle_positions();
+
+    REQUIRE(third != first);
+    REQUIRE(third->size() == 2);
+    REQUIRE(first->size() == 1);
+    REQUIRE_FALSE(terrain.target_position().has_value());
+}
+
+
+TEST_CASE("Terrain visited journal returns only cells since an epoch") {
+    Terrain terrain{3, 3};
+
+    terrain.mark_visited({0, 1});
+    terrain.mark_visited({0, 1});
+
+    std::vector<Position> first;
+    const std::size_t epoch = terrain.visited_since(0, first);
+
+    REQUIRE(epoch == 1);
+    REQUIRE(first.size() == 1);
+
+    terrain.mark_visited({2, 2});
+
+    std::vector<Position> delta;
+
+    REQUIRE(terrain.visited_since(epoch, delta) == 2);
+    REQUIRE(delta.size() == 1);
+    REQUIRE(delta[0] == Position{2, 2});
+}
+
+
+TEST_CASE("Terrain copies share the static layer until one of them writes it") {
+    Terrain base{5, 4};
+
+    base.set_target({4, 3});
+    base.set_obstacle({2, 2});
+
+    Terrain copy = base;
+
+    REQUIRE(copy.static_layer() == base.static_layer());
+
+    // Visiting is run state: it never touches the shared layer.
+    copy.mark_visited({0, 0});
+
+    REQUIRE(copy.static_layer() == base.static_layer());
+    REQUIRE(copy.cell_at({0, 0}).visited);
+    REQUIRE_FALSE(base.cell_at({0, 0}).visited);
+    REQUIRE(base.visited_count() == 0);
+
+    // Changing an obstacle copies the layer for `copy` only.
+    copy.set_obstacle({1, 1});
+
+    REQUIRE(copy.static_layer() != base.static_layer());
+    REQUIRE(copy.cell_at({1, 1}).type == CellType::Obstacle);
+    REQUIRE(base.cell_at({1, 1}).type == CellType::Free);
+    REQUIRE(base.obstacle_positions() == std::vector<Position>{{2, 2}});
+    REQUIRE(copy.obstacle_positions().size() == 2);
+    REQUIRE(copy.cell_at({0, 0}).visited);
+}
+
+
+TEST_CASE("Terrain built on a static layer starts unvisited") {
+    Terrain base{4, 4};
+
+    base.set_target({3, 3});
+    base.set_obstacle({1, 2});
+    base.mark_visited({0, 0});
+
+    Terrain run{base.static_layer()};
+
+    REQUIRE(run.static_layer() == base.static_layer());
+    REQUIRE(run.visited_count() == 0);
+    REQUIRE_FALSE(run.cell_at({0, 0}).visited);
+    REQUIRE(run.cell_at({1, 2}).type == CellType::Obstacle);
+    REQUIRE(run.target_position().value() == Position{3, 3});
+
+    run.set_target({0, 3});
+
+    REQUIRE(run.static_layer() != base.static_layer());
+    REQUIRE(base.target_position().value() == Position{3, 3});
+    REQUIRE(base.cell_at({0, 3}).type == CellType::Free);
+}
+
+
+TEST_CASE("Terrain owns one bit per cell until information gain is used") {
+    Terrain terrain{64, 64};
+
+    // The visited bitplane, sentinel border included.
+    const std::size_t visited_plane = Bitboard{64, 64, false}.storage_bytes();
+
+    REQUIRE(terrain.storage_bytes() == 64 * 64);
+    REQUIRE(terrain.owned_storage_bytes() == visited_plane);
+
+    terrain.mark_visited({1, 0});
+    REQUIRE(terrain.information_gain({0, 0}) == 1);
+
+    REQUIRE(terrain.owned_storage_bytes() == visited_plane + 64 * 64);
+}
+
+
+namespace {
+
+// Brute-force count of the available neighbors of pos.
+template <typename Neighborhood, typename TerrainType>
+int counted_gain(const TerrainType& terrain, const Position& pos) {
+    int available = 0;
+
+    for (const auto& dir : row_directions<Neighborhood>(pos.y)) {
+        const Position next = pos + dir;
+
+        if (terrain.in_bounds(next) &&
+            terrain.cell_at(next).type != CellType::Obstacle &&
+            !terrain.cell_at(next).visited) {
+            ++available;
+        }
+    }
+
+    return available;
+}
+
+
+template <typename Neighborhood>
+void check_neighborhood() {
+    SequentialTerrain<Neighborhood> terrain{5, 5};
+
+    terrain.set_obstacle({2, 1});
+    terrain.mark_visited({1, 2});
+    REQUIRE(terrain.information_gain({2, 2}) ==
+            counted_gain<Neighborhood>(terrain, {2, 2}));
+
+    // Updated incrementally from here on.
+    terrain.mark_visited({3, 3});
+    terrain.set_obstacle({0, 4});
+    terrain.set_target({4, 0});
+
+    for (int y = 0; y < 5; ++y) {
+        for (int x = 0; x < 5; ++x) {
+            const auto neighbors = terrain.available_neighbors({x, y});
+
+            REQUIRE(terrain.information_gain({x, y}) ==
+                    counted_gain<Neighborhood>(terrain, {x, y}));
+            REQUIRE(static_cast<int>(neighbors.size()) ==
+                    counted_gain<Neighborhood>(terrain, {x, y}));
+        }
+    }
+}
+
+} // namespace
+
+
+TEST_CASE("Terrain can be built on every neighborhood") {
+    check_neighborhood<FourConnected>();
+    check_neighborhood<EightConnected>();
+    check_neighborhood<HexOffset>();
+
+    // Center of an odd row: the hex diagonals lean east.
+    SequentialTerrain<HexOffset> hex{3, 3};
+    const auto neighbors = hex.available_neighbors({1, 1});
+
+    const std::vector<Position> expected{
+        {2, 1}, {0, 1}, {1, 0}, {2, 0}, {1, 2}, {2, 2}
+    };
+
+    REQUIRE(neighbors.size() == expected.size());
+
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        REQUIRE(neighbors[i] == expected[i]);
+    }
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include "aeroswarm/live/texel_grid.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+std::vector<TexelTile> take_all(TexelGrid& grid) {
+    std::vector<TexelTile> tiles;
+
+    grid.take_dirty_tiles([&tiles](const TexelTile& tile) {
+        tiles.push_back(tile);
+    });
+
+    return tiles;
+}
+
+} // namespace
+
+
+TEST_CASE("TexelGrid starts with every tile dirty, edge tiles clipped to the map") {
+    TexelGrid grid{100, 70};
+
+    const auto tiles = take_all(grid);
+
+    // 2 x 2 tiles of 64: the right and bottom ones are partial.
+    REQUIRE(tiles.size() == 4);
+
+    REQUIRE(tiles[0].x == 0);
+    REQUIRE(tiles[0].width == 64);
+    REQUIRE(tiles[3].x == 64);
+    REQUIRE(tiles[3].y == 64);
+    REQUIRE(tiles[3].width == 36);
+    REQUIRE(tiles[3].height == 6);
+
+    REQUIRE(grid.dirty_tile_count() == 0);
+    REQUIRE(take_all(grid).empty());
+}
+
+
+TEST_CASE("TexelGrid marks only the tiles of newly visited cells dirty") {
+    TexelGrid grid{256, 256};
+    take_all(grid);
+
+    grid.mark_visited({5, 5});
+    grid.mark_visited({6, 5});
+    grid.mark_visited({200, 130});
+
+    // Visiting a cell twice, or outside the map, changes nothing.
+    grid.mark_visited({5, 5});
+    grid.mark_visited({-1, 3});
+    grid.mark_visited({256, 0});
+
+    const auto tiles = take_all(grid);
+
+    REQUIRE(tiles.size() == 2);
+
+    REQUIRE(tiles[0].x == 0);
+    REQUIRE(tiles[0].y == 0);
+    REQUIRE(tiles[1].x == 192);
+    REQUIRE(tiles[1].y == 128);
+
+    REQUIRE(grid.visited({5, 5}));
+    REQUIRE_FALSE(grid.visited({7, 5}));
+}
+
+
+TEST_CASE("TexelGrid fills a tile with obstacle, visited and free texels") {
+    TexelGrid grid{4, 3};
+
+    grid.set_obstacles({{1, 0}});
+    grid.mark_visited({2, 1});
+    grid.mark_visited({1, 0});
+
+    // Pitch wider than the tile, as SDL_LockTexture may return.
+    constexpr int pitch_texels = 6;
+    std::vector<std::uint32_t> pixels(pitch_texels * 3, 0);
+
+    grid.fill(
+        TexelTile{0, 0, 4, 3},
+        pixels.data(),
+        pitch_texels * static_cast<int>(sizeof(std::uint32_t))
+    );
+
+    // Obstacles win over visited.
+    REQUIRE(pixels[1] == TexelGrid::obstacle_color);
+    REQUIRE(pixels[pitch_texels + 2] == TexelGrid::visited_color);
+    REQUIRE(pixels[0] == TexelGrid::free_color);
+    REQUIRE(pixels[2 * pitch_texels + 3] == TexelGrid::free_color);
+
+    // Padding past the tile width is left alone.
+    REQUIRE(pixels[4] == 0);
+}
+
+
+TEST_CASE("TexelGrid redraws everything after new obstacles or a visited reset") {
+    TexelGrid grid{130, 10};
+    take_all(grid);
+
+    grid.mark_visited({3, 3});
+    grid.clear_visited();
+
+    REQUIRE(take_all(grid).size() == 3);
+    REQUIRE_FALSE(grid.visited({3, 3}));
+
+    grid.set_obstacles({{129, 9}});
+
+    REQUIRE(take_all(grid).size() == 3);
+    REQUIRE(grid.texel_at({129, 9}) == TexelGrid::obstacle_color);
+}